@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "logsconverter.h"
+#include "../../radio/src/logs_binary.h"
+
+bool isBinaryLog(const QString & filename)
+{
+  QFile file(filename);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  return file.read(sizeof(LOGS_BINARY_MAGIC) - 1) == LOGS_BINARY_MAGIC;
+}
+
+template <class T>
+static T readValue(const char * & p)
+{
+  T value;
+  memcpy(&value, p, sizeof(T));
+  p += sizeof(T);
+  return value;
+}
+
+// same formats as the radio CSV logs
+static QString formatPrec(int32_t value, int prec)
+{
+  if (prec == 0) {
+    return QString::number(value);
+  }
+  int divisor = (prec == 1 ? 10 : 100);
+  return QString("%1%2.%3").arg(value < 0 ? "-" : "").arg(abs(value / divisor)).arg(abs(value % divisor), prec, 10, QChar('0'));
+}
+
+static QString formatColumn(uint8_t type, const char * & p)
+{
+  switch (type) {
+    case LOGS_COLUMN_TIME:
+      return QString::number(readValue<uint32_t>(p));
+
+    case LOGS_COLUMN_DATE_TIME:
+    {
+      QDateTime time = QDateTime::fromTime_t(readValue<uint32_t>(p), Qt::UTC);
+      int ms10 = readValue<uint8_t>(p);
+      return time.toString("yyyy-MM-dd,hh:mm:ss") + QString(".%1").arg(ms10, 2, 10, QChar('0')) + "0";
+    }
+
+    case LOGS_COLUMN_VALUE:
+      return formatPrec(readValue<int32_t>(p), 0);
+
+    case LOGS_COLUMN_VALUE_PREC1:
+      return formatPrec(readValue<int32_t>(p), 1);
+
+    case LOGS_COLUMN_VALUE_PREC2:
+      return formatPrec(readValue<int32_t>(p), 2);
+
+    case LOGS_COLUMN_GPS:
+    {
+      int32_t latitude = readValue<int32_t>(p);
+      int32_t longitude = readValue<int32_t>(p);
+      if (!latitude || !longitude) {
+        return QString();
+      }
+      return QString("%1%2.%3 %4%5.%6")
+          .arg(latitude < 0 ? "-" : "").arg(abs(latitude / 1000000)).arg(abs(latitude % 1000000), 6, 10, QChar('0'))
+          .arg(longitude < 0 ? "-" : "").arg(abs(longitude / 1000000)).arg(abs(longitude % 1000000), 6, 10, QChar('0'));
+    }
+
+    case LOGS_COLUMN_SENSOR_DATE_TIME:
+    {
+      uint16_t year = readValue<uint16_t>(p);
+      uint8_t month = readValue<uint8_t>(p);
+      uint8_t day = readValue<uint8_t>(p);
+      uint8_t hour = readValue<uint8_t>(p);
+      uint8_t min = readValue<uint8_t>(p);
+      uint8_t sec = readValue<uint8_t>(p);
+      return QString().sprintf("%4d-%02d-%02d %02d:%02d:%02d", year, month, day, hour, min, sec);
+    }
+
+    case LOGS_COLUMN_ANALOG:
+      return QString::number(readValue<int16_t>(p));
+
+    case LOGS_COLUMN_SWITCH:
+      return QString::number(readValue<int8_t>(p));
+
+    case LOGS_COLUMN_LOGICAL_SWITCHES:
+    {
+      uint32_t high = readValue<uint32_t>(p);
+      uint32_t low = readValue<uint32_t>(p);
+      return QString().sprintf("0x%08X%08X", high, low);
+    }
+
+    default:
+      return QString();
+  }
+}
+
+// a session header is only taken as such when its version is known, a row may contain the magic by chance
+static bool isBinaryHeader(const char * p, const char * end)
+{
+  return end - p >= (int)sizeof(LogsBinaryHeader) && !memcmp(p, LOGS_BINARY_MAGIC, sizeof(LOGS_BINARY_MAGIC) - 1) && ((const LogsBinaryHeader *)p)->version == LOGS_BINARY_VERSION;
+}
+
+// the first session header starting in [p, last), or last if none
+static const char * findBinaryHeader(const char * p, const char * last, const char * end)
+{
+  for (; p < last; p++) {
+    if (isBinaryHeader(p, end)) {
+      return p;
+    }
+  }
+  return last;
+}
+
+// The sessions appended to the same file may log different columns. They are
+// all converted to one CSV header, the union of the sessions columns in their
+// order of appearance, the fields a session does not log are left empty.
+bool convertBinaryLog(const QString & filename, QStringList & lines, QString & error)
+{
+  QFile file(filename);
+  if (!file.open(QIODevice::ReadOnly)) {
+    error = file.errorString();
+    return false;
+  }
+
+  QByteArray data = file.readAll();
+  const char * p = data.constData();
+  const char * end = p + data.size();
+  QByteArray types;
+  int rowSize = 0;
+  int skippedBytes = 0;
+  QStringList header;
+  QHash<QString, QList<int>> headerColumns; // the indexes in header of each name, a name may be repeated
+  QVector<int> mapping;                     // the index in header of each field of the current session
+  QList<QStringList> rows;
+
+  while (p < end) {
+    if ((uint8_t)*p == LOGS_BINARY_ROW_MARKER && rowSize > 0) {
+      const char * rowEnd = (end - p < rowSize ? end : p + rowSize);
+      const char * next = findBinaryHeader(p + 1, rowEnd, end);
+      if (next < rowEnd) {
+        // the radio was switched off while writing this row, the next session follows
+        skippedBytes += next - p;
+        p = next;
+        continue;
+      }
+      if (end - p < rowSize) {
+        // the radio was switched off while writing this row
+        skippedBytes += end - p;
+        break;
+      }
+      const char * row = p + 1;
+      QStringList columns;
+      for (int i = 0; i < types.size(); i++) {
+        columns << formatColumn(types[i], row);
+      }
+      // a column may give several CSV fields
+      QStringList fields = columns.join(",").split(',');
+      QStringList values;
+      for (int i = 0; i < fields.size() && i < mapping.size(); i++) {
+        int index = mapping[i];
+        while (values.size() <= index) {
+          values << QString();
+        }
+        values[index] = fields[i];
+      }
+      rows << values;
+      p += rowSize;
+    }
+    else if (end - p >= (int)sizeof(LogsBinaryHeader) && !memcmp(p, LOGS_BINARY_MAGIC, sizeof(LOGS_BINARY_MAGIC) - 1)) {
+      LogsBinaryHeader binaryHeader;
+      memcpy(&binaryHeader, p, sizeof(binaryHeader));
+      p += sizeof(binaryHeader);
+      if (binaryHeader.version != LOGS_BINARY_VERSION || end - p < binaryHeader.columns + binaryHeader.namesLength) {
+        error = QCoreApplication::translate("LogsConverter", "Unsupported log file version or truncated header");
+        return false;
+      }
+      types = QByteArray(p, binaryHeader.columns);
+      p += binaryHeader.columns;
+      int expectedRowSize = 1;
+      for (int i = 0; i < types.size(); i++) {
+        if ((uint8_t)types[i] >= LOGS_COLUMN_TYPES_COUNT) {
+          error = QCoreApplication::translate("LogsConverter", "Unknown column type %1").arg((int)types[i]);
+          return false;
+        }
+        expectedRowSize += LOGS_COLUMN_SIZES[(uint8_t)types[i]];
+      }
+      if (expectedRowSize != binaryHeader.rowSize) {
+        error = QCoreApplication::translate("LogsConverter", "Inconsistent row size in log file header");
+        return false;
+      }
+      rowSize = binaryHeader.rowSize;
+
+      // the n-th field with a given name goes to the n-th column with this name
+      QStringList names = QString::fromLatin1(p, binaryHeader.namesLength).split(',');
+      p += binaryHeader.namesLength;
+      QHash<QString, int> occurrences;
+      mapping.clear();
+      foreach (const QString & name, names) {
+        int occurrence = occurrences[name]++;
+        QList<int> & indexes = headerColumns[name];
+        if (occurrence == indexes.size()) {
+          indexes << header.size();
+          header << name;
+        }
+        mapping << indexes[occurrence];
+      }
+    }
+    else {
+      // resynchronize on the next row or header
+      skippedBytes++;
+      p++;
+    }
+  }
+
+  if (skippedBytes > 0) {
+    qDebug() << "convertBinaryLog:" << skippedBytes << "bytes skipped";
+  }
+
+  if (!header.isEmpty()) {
+    lines << header.join(",");
+    foreach (QStringList values, rows) {
+      while (values.size() < header.size()) {
+        values << QString();
+      }
+      lines << values.join(",");
+    }
+  }
+
+  return true;
+}
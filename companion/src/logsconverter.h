@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _LOGSCONVERTER_H_
+#define _LOGSCONVERTER_H_
+
+#include <QtCore>
+
+// Binary logs written by the radio LOG_BINARY option
+
+bool isBinaryLog(const QString & filename);
+
+// Converts a binary log to the lines of the equivalent CSV log (the header lines included)
+bool convertBinaryLog(const QString & filename, QStringList & lines, QString & error);
+
+#endif // _LOGSCONVERTER_H_
@@ -23,6 +23,7 @@
 #include "appdata.h"
 #include "ui_logsdialog.h"
 #include "helpers.h"
+#include "logsconverter.h"
 #if defined _MSC_VER || !defined __GNUC__
 #include <windows.h>
 #else
@@ -656,42 +657,48 @@ bool LogsDialog::cvsFileParse()
   QFile file(ui->FileName_LE->text());
   int errors=0;
   int lines=-1;
+  QStringList fileLines;
 
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
+  if (isBinaryLog(file.fileName())) {
+    QString error;
+    if (!convertBinaryLog(file.fileName(), fileLines, error)) {
+      QMessageBox::warning(this, CPN_STR_APP_NAME, tr("Cannot convert the binary logfile: %1").arg(error));
+      return false;
+    }
+  }
+  else if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
     return false;
   }
   else {
-    csvlog.clear();
-    logFilename.clear();
-    QTextStream inputStream(&file);
-    QString buffer = file.readLine();
+    while (!file.atEnd()) {
+      fileLines.append(file.readLine().trimmed());
+    }
+  }
+
+  csvlog.clear();
+  logFilename.clear();
+
+  if (fileLines.isEmpty() || !fileLines.first().startsWith("Date,Time")) {
+    return false;
+  }
 
-    if (buffer.startsWith("Date,Time")) {
-      file.reset();
+  int numfields=-1;
+  foreach (const QString & line, fileLines) {
+    QStringList columns = line.split(',');
+    if (numfields==-1) {
+      numfields=columns.count();
     }
-    else {
-      return false;
+    if (columns.count()==numfields) {
+      csvlog.append(columns);
     }
-
-    int numfields=-1;
-    while (!file.atEnd()) {
-      QString line = file.readLine().trimmed();
-      QStringList columns = line.split(',');
-      if (numfields==-1) {
-        numfields=columns.count();
-      }
-      if (columns.count()==numfields) {
-        csvlog.append(columns);
-      }
-      else {
-        errors++;
-      }
-      lines++;
+    else {
+      errors++;
     }
-
-    logFilename = QFileInfo(file.fileName()).baseName();
+    lines++;
   }
 
+  logFilename = QFileInfo(file.fileName()).baseName();
+
   file.close();
   if (errors > 1) {
     QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(errors).arg(lines));
@@ -127,6 +127,7 @@ class SimulatorInterface : public QObject
     virtual uint8_t getSensorInstance(uint16_t id, uint8_t defaultValue = 0) = 0;
     virtual uint16_t getSensorRatio(uint16_t id) = 0;
     virtual const int getCapability(Capability cap) = 0;
+    virtual QString getMixerTimings() = 0;  // CSV, one line per timing histogram
   public slots:
 
     virtual void init() = 0;
@@ -34,6 +34,7 @@
 
 #include <QDebug>
 #include <QDir>
+#include <QFileDialog>
 #include <QLabel>
 #include <QMessageBox>
 
@@ -130,6 +131,7 @@ SimulatorMainWindow::SimulatorMainWindow(QWidget *parent, const QString & firmwa
 
   connect(ui->actionShowKeymap, &QAction::triggered, this, &SimulatorMainWindow::showHelp);
   connect(ui->actionJoystickSettings, &QAction::triggered, this, &SimulatorMainWindow::openJoystickDialog);
+  connect(ui->actionExportMixerTimings, &QAction::triggered, this, &SimulatorMainWindow::exportMixerTimings);
   connect(ui->actionToggleMenuBar, &QAction::toggled, this, &SimulatorMainWindow::showMenuBar);
   connect(ui->actionFixedRadioWidth, &QAction::toggled, this, &SimulatorMainWindow::showRadioFixedWidth);
   connect(ui->actionFixedRadioHeight, &QAction::toggled, this, &SimulatorMainWindow::showRadioFixedHeight);
@@ -476,6 +478,20 @@ void SimulatorMainWindow::openJoystickDialog(bool)
 #endif
 }
 
+void SimulatorMainWindow::exportMixerTimings(bool)
+{
+  QString fileName = QFileDialog::getSaveFileName(this, tr("Export Mixer Timings"), g.eepromDir() % "/mixer_timings.csv", tr("CSV files (*.csv)"));
+  if (fileName.isEmpty())
+    return;
+
+  QFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("Cannot write file %1:\n%2.").arg(fileName, file.errorString()));
+    return;
+  }
+  file.write(m_simulator->getMixerTimings().toUtf8());
+}
+
 void SimulatorMainWindow::showHelp(bool show)
 {
   QString helpText = ""
@@ -80,6 +80,7 @@ class SimulatorMainWindow : public QMainWindow
     void setRadioSizePolicy(int fixType);
     void toggleRadioDocked(bool dock);
     void openJoystickDialog(bool);
+    void exportMixerTimings(bool);
     void showHelp(bool show);
 
   protected:
@@ -20,6 +20,7 @@
 
 #include "opentx.h"
 #include <math.h>
+#include <ctype.h>
 
 extern RTOS_MUTEX_HANDLE audioMutex;
 
@@ -248,43 +249,6 @@ void getSystemAudioFile(char * filename, int index)
   strcat(str, SOUNDS_EXT);
 }
 
-void referenceSystemAudioFiles()
-{
-  TRACE("referenceSystemAudioFiles");
-  static_assert(sizeof(audioFilenames)==AU_SPECIAL_SOUND_FIRST*sizeof(char *), "Invalid audioFilenames size");
-  char path[AUDIO_FILENAME_MAXLEN+1];
-  FILINFO fno;
-  DIR dir;
-
-  sdAvailableSystemAudioFiles.reset();
-
-  char * filename = strAppendSystemAudioPath(path);
-  *(filename-1) = '\0';
-
-  FRESULT res = f_opendir(&dir, path);        /* Open the directory */
-  if (res == FR_OK) {
-    for (;;) {
-      res = f_readdir(&dir, &fno);                   /* Read a directory item */
-      if (res != FR_OK || fno.fname[0] == 0) break;  /* Break on error or end of dir */
-      uint8_t len = strlen(fno.fname);
-
-      // Eliminates directories / non wav files
-      if (len < 5 || strcasecmp(fno.fname+len-4, SOUNDS_EXT) || (fno.fattrib & AM_DIR)) continue;
-
-      for (int i=0; i<AU_SPECIAL_SOUND_FIRST; i++) {
-        getSystemAudioFile(path, i);
-        if (!strcasecmp(filename, fno.fname)) {
-          sdAvailableSystemAudioFiles.setBit(i);
-          //TRACE("referenceSystemAudioFiles: Found %s", filename);
-          break;
-        }
-      }
-    }
-    f_closedir(&dir);
-  }
-  TRACE("referenceSystemAudioFiles done");
-}
-
 const char * const suffixes[] = { "-off", "-on" };
 
 char * getModelAudioPath(char * path)
@@ -357,74 +321,177 @@ void getLogicalSwitchAudioFile(char * filename, int index, unsigned int event)
   strcat(str, SOUNDS_EXT);
 }
 
-void referenceModelAudioFiles()
+// The expected files of a directory are sorted by the case insensitive hash of their names,
+// each directory entry is then found with a binary search instead of being compared with all
+// of them
+struct AudioFileIndexEntry {
+  uint32_t hash;
+  uint8_t  category;
+  uint16_t index;
+};
+
+#define MODEL_AUDIO_FILES_COUNT        (MAX_FLIGHT_MODES*2 + SWSRC_LAST_SWITCH+NUM_XPOTS*XPOTS_MULTIPOS_COUNT - SWSRC_FIRST_SWITCH + 1 + MAX_LOGICAL_SWITCHES*2)
+
+static AudioFileIndexEntry systemAudioFilesIndex[AU_SPECIAL_SOUND_FIRST];
+static uint16_t systemAudioFilesCount = 0;
+static AudioFileIndexEntry modelAudioFilesIndex[MODEL_AUDIO_FILES_COUNT];
+static uint16_t modelAudioFilesCount = 0;
+
+static uint32_t audioFilenameHash(const char * filename)
+{
+  uint32_t hash = 5381;
+  while (*filename) {
+    hash = ((hash << 5) + hash) + tolower((unsigned char)*filename++);
+  }
+  return hash;
+}
+
+static void getIndexedAudioFile(char * filename, const AudioFileIndexEntry & entry)
+{
+  switch (entry.category) {
+    case SYSTEM_AUDIO_CATEGORY:
+      getSystemAudioFile(filename, entry.index);
+      break;
+    case PHASE_AUDIO_CATEGORY:
+      getPhaseAudioFile(filename, entry.index / 2, entry.index % 2);
+      break;
+    case SWITCH_AUDIO_CATEGORY:
+      getSwitchAudioFile(filename, SWSRC_FIRST_SWITCH + entry.index);
+      break;
+    case LOGICAL_SWITCH_AUDIO_CATEGORY:
+      getLogicalSwitchAudioFile(filename, entry.index / 2, entry.index % 2);
+      break;
+  }
+}
+
+static void setAudioFileAvailable(const AudioFileIndexEntry & entry)
+{
+  switch (entry.category) {
+    case SYSTEM_AUDIO_CATEGORY:
+      sdAvailableSystemAudioFiles.setBit(entry.index);
+      break;
+    case PHASE_AUDIO_CATEGORY:
+      sdAvailablePhaseAudioFiles.setBit(entry.index);
+      break;
+    case SWITCH_AUDIO_CATEGORY:
+      sdAvailableSwitchAudioFiles.setBit(entry.index);
+      break;
+    case LOGICAL_SWITCH_AUDIO_CATEGORY:
+      sdAvailableLogicalSwitchAudioFiles.setBit(entry.index);
+      break;
+  }
+}
+
+// the entries with the same hash stay in their insertion order, the first inserted file wins
+static void insertAudioFile(AudioFileIndexEntry * index, uint16_t & count, uint8_t category, uint16_t bit)
+{
+  char path[AUDIO_FILENAME_MAXLEN+1];
+  AudioFileIndexEntry entry = { 0, category, bit };
+  getIndexedAudioFile(path, entry);
+  entry.hash = audioFilenameHash(strrchr(path, '/') + 1);
+
+  uint16_t i = count++;
+  while (i > 0 && index[i-1].hash > entry.hash) {
+    index[i] = index[i-1];
+    i--;
+  }
+  index[i] = entry;
+}
+
+static void referenceIndexedAudioFiles(const char * directory, const AudioFileIndexEntry * index, uint16_t count)
 {
-  TRACE("referenceModelAudioFiles");
-  
   char path[AUDIO_FILENAME_MAXLEN+1];
   FILINFO fno;
   DIR dir;
 
-  sdAvailablePhaseAudioFiles.reset();
-  sdAvailableSwitchAudioFiles.reset();
-  sdAvailableLogicalSwitchAudioFiles.reset();
-
-  char * filename = getModelAudioPath(path);
-  *(filename-1) = '\0';
-
-  FRESULT res = f_opendir(&dir, path);        /* Open the directory */
+  FRESULT res = f_opendir(&dir, directory);        /* Open the directory */
   if (res == FR_OK) {
     for (;;) {
       res = f_readdir(&dir, &fno);                   /* Read a directory item */
       if (res != FR_OK || fno.fname[0] == 0) break;  /* Break on error or end of dir */
       uint8_t len = strlen(fno.fname);
-      bool found = false;
 
       // Eliminates directories / non wav files
       if (len < 5 || strcasecmp(fno.fname+len-4, SOUNDS_EXT) || (fno.fattrib & AM_DIR)) continue;
-      TRACE("referenceModelAudioFiles(): using file: %s", fno.fname);
-
-      // Phases Audio Files <phasename>-[on|off].wav
-      for (int i=0; i<MAX_FLIGHT_MODES && !found; i++) {
-        for (int event=0; event<2; event++) {
-          getPhaseAudioFile(path, i, event);
-          // TRACE("referenceModelAudioFiles(): searching for %s in %s", filename, fno.fname);
-          if (!strcasecmp(filename, fno.fname)) {
-            sdAvailablePhaseAudioFiles.setBit(INDEX_PHASE_AUDIO_FILE(i, event));
-            found = true;
-            TRACE("\tfound: %s", filename);
-            break;
-          }
-        }
-      }
 
-      // Switches Audio Files <switchname>-[up|mid|down].wav
-      for (int i=SWSRC_FIRST_SWITCH; i<=SWSRC_LAST_SWITCH+NUM_XPOTS*XPOTS_MULTIPOS_COUNT && !found; i++) {
-        getSwitchAudioFile(path, i);
-        // TRACE("referenceModelAudioFiles(): searching for %s in %s (%d)", path, fno.fname, i);
-        if (!strcasecmp(filename, fno.fname)) {
-          sdAvailableSwitchAudioFiles.setBit(i-SWSRC_FIRST_SWITCH);
-          found = true;
-          TRACE("\tfound: %s", filename);
-        }
+      uint32_t hash = audioFilenameHash(fno.fname);
+      uint16_t first = 0, last = count;
+      while (first < last) {
+        uint16_t middle = (first + last) / 2;
+        if (index[middle].hash < hash)
+          first = middle + 1;
+        else
+          last = middle;
       }
 
-      // Logical Switches Audio Files <switchname>-[on|off].wav
-      for (int i=0; i<MAX_LOGICAL_SWITCHES && !found; i++) {
-        for (int event=0; event<2; event++) {
-          getLogicalSwitchAudioFile(path, i, event);
-          // TRACE("referenceModelAudioFiles(): searching for %s in %s", filename, fno.fname);
-          if (!strcasecmp(filename, fno.fname)) {
-            sdAvailableLogicalSwitchAudioFiles.setBit(INDEX_LOGICAL_SWITCH_AUDIO_FILE(i, event));
-            found = true;
-            TRACE("\tfound: %s", filename);
-            break;
-          }
+      // the hash may collide, the names are compared to be sure
+      for (uint16_t i=first; i<count && index[i].hash == hash; i++) {
+        getIndexedAudioFile(path, index[i]);
+        if (!strcasecmp(strrchr(path, '/') + 1, fno.fname)) {
+          setAudioFileAvailable(index[i]);
+          break;
         }
       }
     }
     f_closedir(&dir);
   }
+}
+
+void referenceSystemAudioFiles()
+{
+  TRACE("referenceSystemAudioFiles");
+  static_assert(sizeof(audioFilenames)==AU_SPECIAL_SOUND_FIRST*sizeof(char *), "Invalid audioFilenames size");
+  char path[AUDIO_FILENAME_MAXLEN+1];
+
+  sdAvailableSystemAudioFiles.reset();
+
+  // the system files names don't depend on the language, the index is built once
+  if (systemAudioFilesCount == 0) {
+    for (int i=0; i<AU_SPECIAL_SOUND_FIRST; i++) {
+      insertAudioFile(systemAudioFilesIndex, systemAudioFilesCount, SYSTEM_AUDIO_CATEGORY, i);
+    }
+  }
+
+  char * filename = strAppendSystemAudioPath(path);
+  *(filename-1) = '\0';
+  referenceIndexedAudioFiles(path, systemAudioFilesIndex, systemAudioFilesCount);
+
+  TRACE("referenceSystemAudioFiles done");
+}
+
+void referenceModelAudioFiles()
+{
+  TRACE("referenceModelAudioFiles");
+
+  char path[AUDIO_FILENAME_MAXLEN+1];
+
+  sdAvailablePhaseAudioFiles.reset();
+  sdAvailableSwitchAudioFiles.reset();
+  sdAvailableLogicalSwitchAudioFiles.reset();
+
+  // the flight modes names change with the model, the index is built again
+  // Phases Audio Files <phasename>-[on|off].wav
+  // Switches Audio Files <switchname>-[up|mid|down].wav
+  // Logical Switches Audio Files <switchname>-[on|off].wav
+  modelAudioFilesCount = 0;
+  for (int i=0; i<MAX_FLIGHT_MODES; i++) {
+    for (int event=0; event<2; event++) {
+      insertAudioFile(modelAudioFilesIndex, modelAudioFilesCount, PHASE_AUDIO_CATEGORY, INDEX_PHASE_AUDIO_FILE(i, event));
+    }
+  }
+  for (int i=SWSRC_FIRST_SWITCH; i<=SWSRC_LAST_SWITCH+NUM_XPOTS*XPOTS_MULTIPOS_COUNT; i++) {
+    insertAudioFile(modelAudioFilesIndex, modelAudioFilesCount, SWITCH_AUDIO_CATEGORY, i-SWSRC_FIRST_SWITCH);
+  }
+  for (int i=0; i<MAX_LOGICAL_SWITCHES; i++) {
+    for (int event=0; event<2; event++) {
+      insertAudioFile(modelAudioFilesIndex, modelAudioFilesCount, LOGICAL_SWITCH_AUDIO_CATEGORY, INDEX_LOGICAL_SWITCH_AUDIO_FILE(i, event));
+    }
+  }
+
+  char * filename = getModelAudioPath(path);
+  *(filename-1) = '\0';
+  referenceIndexedAudioFiles(path, modelAudioFilesIndex, modelAudioFilesCount);
+
   TRACE("referenceModelAudioFiles done");
 }
 
@@ -556,97 +623,226 @@ inline void mixSample(audio_data_t * result, int sample, unsigned int fade)
   *result = limit(AUDIO_DATA_MIN, *result + ((sample >> fade) >> (16-AUDIO_BITS_PER_SAMPLE)), AUDIO_DATA_MAX);
 }
 
+// the samples of each context are prepared in this block before being mixed
+static int16_t mixBlock[AUDIO_BUFFER_SIZE] __ALIGNED(4);
+
+#if !defined(SIMU) && (defined(PCBX12S) || defined(PCBNV14))
+// 16 bits signed buffers, 2 samples are added at once with saturation
+inline void mixSamples(audio_data_t * result, const int16_t * samples, uint32_t count, unsigned int fade)
+{
+  for (uint32_t i=0; i+1<count; i+=2) {
+    uint32_t pair;
+    memcpy(&pair, &result[i], sizeof(pair));
+    pair = __QADD16(pair, (uint16_t)(samples[i] >> fade) + ((uint32_t)(samples[i+1] >> fade) << 16));
+    memcpy(&result[i], &pair, sizeof(pair));
+  }
+  if (count & 1) {
+    result[count-1] = __SSAT(result[count-1] + (samples[count-1] >> fade), 16);
+  }
+}
+#else
+inline void mixSamples(audio_data_t * result, const int16_t * samples, uint32_t count, unsigned int fade)
+{
+  for (uint32_t i=0; i<count; i++) {
+    mixSample(&result[i], samples[i], fade);
+  }
+}
+#endif
+
 #if defined(SDCARD)
 
 #define RIFF_CHUNK_SIZE 12
-uint8_t wavBuffer[AUDIO_BUFFER_SIZE*2] __DMA;
+#define WAV_MAX_FREQ    48000
+// the samples needed for one audio buffer, at the highest frequency
+uint8_t wavBuffer[2*(AUDIO_BUFFER_SIZE*WAV_MAX_FREQ/AUDIO_SAMPLE_RATE+1)] __DMA;
+
+// parsed headers of the last played files, most prompts are played again and again
+struct WavHeader {
+  uint32_t hash;
+  uint32_t dataOffset;
+  uint32_t dataSize;
+  uint32_t freq;
+  uint8_t  codec;
+};
 
-int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
+#define WAV_HEADERS_CACHE_SIZE 16
+static WavHeader wavHeadersCache[WAV_HEADERS_CACHE_SIZE];
+static uint8_t wavHeadersCacheNext = 0;
+
+static const WavHeader * findWavHeader(uint32_t hash)
 {
-  FRESULT result = FR_OK;
-  UINT read = 0;
+  for (uint8_t i=0; i<WAV_HEADERS_CACHE_SIZE; i++) {
+    if (wavHeadersCache[i].hash == hash) {
+      return &wavHeadersCache[i];
+    }
+  }
+  return NULL;
+}
 
-  if (fragment.file[1]) {
-    result = f_open(&state.file, fragment.file, FA_OPEN_EXISTING | FA_READ);
-    fragment.file[1] = 0;
-    if (result == FR_OK) {
-      result = f_read(&state.file, wavBuffer, RIFF_CHUNK_SIZE+8, &read);
-      if (result == FR_OK && read == RIFF_CHUNK_SIZE+8 && !memcmp(wavBuffer, "RIFF", 4) && !memcmp(wavBuffer+8, "WAVEfmt ", 8)) {
-        uint32_t size = *((uint32_t *)(wavBuffer+16));
-        result = (size < 256 ? f_read(&state.file, wavBuffer, size+8, &read) : FR_DENIED);
-        if (result == FR_OK && read == size+8) {
-          state.codec = ((uint16_t *)wavBuffer)[0];
-          state.freq = ((uint16_t *)wavBuffer)[2];
-          uint32_t *wavSamplesPtr = (uint32_t *)(wavBuffer + size);
-          uint32_t size = wavSamplesPtr[1];
-          if (state.freq != 0 && state.freq * (AUDIO_SAMPLE_RATE / state.freq) == AUDIO_SAMPLE_RATE) {
-            state.resampleRatio = (AUDIO_SAMPLE_RATE / state.freq);
-            state.readSize = (state.codec == CODEC_ID_PCM_S16LE ? 2*AUDIO_BUFFER_SIZE : AUDIO_BUFFER_SIZE) / state.resampleRatio;
-          }
-          else {
-            result = FR_DENIED;
-          }
-          while (result == FR_OK && memcmp(wavSamplesPtr, "data", 4) != 0) {
-            result = f_lseek(&state.file, f_tell(&state.file)+size);
-            if (result == FR_OK) {
-              result = f_read(&state.file, wavBuffer, 8, &read);
-              if (read != 8) result = FR_DENIED;
-              wavSamplesPtr = (uint32_t *)wavBuffer;
-              size = wavSamplesPtr[1];
-            }
+FRESULT WavContext::openFile()
+{
+  UINT read = 0;
+  uint32_t hash = MathUtil::hash(fragment.file, strlen(fragment.file));
+
+  FRESULT result = f_open(&state.file, fragment.file, FA_OPEN_EXISTING | FA_READ);
+  if (result != FR_OK)
+    return result;
+
+  const WavHeader * header = findWavHeader(hash);
+  if (header) {
+    state.codec = header->codec;
+    state.freq = header->freq;
+    state.size = header->dataSize;
+    result = f_lseek(&state.file, header->dataOffset);
+  }
+  else {
+    result = f_read(&state.file, wavBuffer, RIFF_CHUNK_SIZE+8, &read);
+    if (result == FR_OK && read == RIFF_CHUNK_SIZE+8 && !memcmp(wavBuffer, "RIFF", 4) && !memcmp(wavBuffer+8, "WAVEfmt ", 8)) {
+      uint32_t size = *((uint32_t *)(wavBuffer+16));
+      result = (size < 256 ? f_read(&state.file, wavBuffer, size+8, &read) : FR_DENIED);
+      if (result == FR_OK && read == size+8) {
+        state.codec = ((uint16_t *)wavBuffer)[0];
+        state.freq = ((uint16_t *)wavBuffer)[2];
+        uint32_t *wavSamplesPtr = (uint32_t *)(wavBuffer + size);
+        uint32_t size = wavSamplesPtr[1];
+        while (result == FR_OK && memcmp(wavSamplesPtr, "data", 4) != 0) {
+          result = f_lseek(&state.file, f_tell(&state.file)+size);
+          if (result == FR_OK) {
+            result = f_read(&state.file, wavBuffer, 8, &read);
+            if (read != 8) result = FR_DENIED;
+            wavSamplesPtr = (uint32_t *)wavBuffer;
+            size = wavSamplesPtr[1];
           }
-          state.size = size;
         }
-        else {
-          result = FR_DENIED;
+        state.size = size;
+        if (result == FR_OK) {
+          WavHeader & entry = wavHeadersCache[wavHeadersCacheNext];
+          wavHeadersCacheNext = (wavHeadersCacheNext + 1) % WAV_HEADERS_CACHE_SIZE;
+          entry.hash = hash;
+          entry.dataOffset = f_tell(&state.file);
+          entry.dataSize = size;
+          entry.freq = state.freq;
+          entry.codec = state.codec;
         }
       }
       else {
         result = FR_DENIED;
       }
     }
+    else {
+      result = FR_DENIED;
+    }
   }
 
   if (result == FR_OK) {
-    read = 0;
-    result = f_read(&state.file, wavBuffer, state.readSize, &read);
-    if (result == FR_OK) {
-      if (read > state.size) {
-        read = state.size;
-      }
-      state.size -= read;
+    if (state.codec != CODEC_ID_PCM_S16LE && state.codec != CODEC_ID_PCM_ALAW && state.codec != CODEC_ID_PCM_MULAW) {
+      result = FR_DENIED;
+    }
+    else if (state.freq != 0 && state.freq <= WAV_MAX_FREQ) {
+      state.step = (state.freq << 16) / AUDIO_SAMPLE_RATE;
+      state.position = 0;
+    }
+    else {
+      result = FR_DENIED;
+    }
+  }
 
-      if (read != state.readSize) {
-        f_close(&state.file);
-        fragment.clear();
-      }
+  state.bufferStart = f_tell(&state.file) % WAV_READ_BUFFER_SIZE;
+  state.bufferCount = 0;
+
+  return result;
+}
 
-      audio_data_t * samples = buffer->data;
+FRESULT WavContext::readAhead()
+{
+  while (state.size > 0) {
+    uint32_t position = f_tell(&state.file);
+    uint32_t chunk = WAV_READ_CHUNK_SIZE - (position % WAV_READ_CHUNK_SIZE);
+    if (chunk > state.size) {
+      chunk = state.size;
+    }
+    if (state.bufferCount + chunk > WAV_READ_BUFFER_SIZE) {
+      break;
+    }
+    UINT read = 0;
+    FRESULT result = f_read(&state.file, &state.buffer[position % WAV_READ_BUFFER_SIZE], chunk, &read);
+    if (result != FR_OK) {
+      return result;
+    }
+    state.bufferCount += read;
+    state.size = (read == chunk ? state.size - read : 0);
+  }
+  return FR_OK;
+}
+
+void WavContext::prefetch()
+{
+  // nothing to do until the file is opened by mixBuffer()
+  if (fragment.type == FRAGMENT_FILE && !fragment.file[1]) {
+    if (readAhead() != FR_OK) {
+      state.size = 0;
+    }
+  }
+}
+
+int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
+{
+  FRESULT result = FR_OK;
+
+  if (fragment.file[1]) {
+    result = openFile();
+    fragment.file[1] = 0;
+  }
+
+  if (result == FR_OK) {
+    result = readAhead();
+  }
+
+  if (result == FR_OK) {
+    // the samples are held until the 16.16 position reaches the next one
+    uint32_t sampleSize = (state.codec == CODEC_ID_PCM_S16LE ? 2 : 1);
+    uint32_t available = state.bufferCount / sampleSize;
+    uint32_t count = AUDIO_BUFFER_SIZE;
+    if (((state.position + (count - 1) * state.step) >> 16) >= available) {
+      // end of file
+      count = ((available << 16) > state.position ? ((available << 16) - state.position + state.step - 1) / state.step : 0);
+      f_close(&state.file);
+      fragment.clear();
+    }
+
+    if (count > 0) {
+      uint32_t needed = ((state.position + (count - 1) * state.step) >> 16) + 1;
+      uint32_t consumed = min<uint32_t>((state.position + count * state.step) >> 16, available);
+      uint32_t size = needed * sampleSize;
+      uint32_t first = min<uint32_t>(size, WAV_READ_BUFFER_SIZE - state.bufferStart);
+      memcpy(wavBuffer, &state.buffer[state.bufferStart], first);
+      memcpy(wavBuffer + first, state.buffer, size - first);
+      state.bufferStart = (state.bufferStart + consumed * sampleSize) % WAV_READ_BUFFER_SIZE;
+      state.bufferCount -= consumed * sampleSize;
+
+      uint32_t position = state.position;
       if (state.codec == CODEC_ID_PCM_S16LE) {
-        read /= 2;
-        for (uint32_t i=0; i<read; i++) {
-          for (uint8_t j=0; j<state.resampleRatio; j++) {
-            mixSample(samples++, ((int16_t *)wavBuffer)[i], fade+2-volume);
-          }
+        const int16_t * samples = (const int16_t *)wavBuffer;
+        for (uint32_t i=0; i<count; i++, position+=state.step) {
+          mixBlock[i] = samples[position >> 16];
         }
       }
       else if (state.codec == CODEC_ID_PCM_ALAW) {
-        for (uint32_t i=0; i<read; i++) {
-          for (uint8_t j=0; j<state.resampleRatio; j++) {
-            mixSample(samples++, alawTable[wavBuffer[i]], fade+2-volume);
-          }
+        for (uint32_t i=0; i<count; i++, position+=state.step) {
+          mixBlock[i] = alawTable[wavBuffer[position >> 16]];
         }
       }
       else if (state.codec == CODEC_ID_PCM_MULAW) {
-        for (uint32_t i=0; i<read; i++) {
-          for (uint8_t j=0; j<state.resampleRatio; j++) {
-            mixSample(samples++, ulawTable[wavBuffer[i]], fade+2-volume);
-          }
+        for (uint32_t i=0; i<count; i++, position+=state.step) {
+          mixBlock[i] = ulawTable[wavBuffer[position >> 16]];
         }
       }
+      state.position = position & 0xFFFF;
 
-      return samples - buffer->data;
+      mixSamples(buffer->data, mixBlock, count, fade+2-volume);
     }
+
+    return count;
   }
 
   if (result != FR_OK) {
@@ -679,7 +875,7 @@ int ToneContext::mixBuffer(AudioBuffer * buffer, int volume, unsigned int fade)
   int remainingDuration = fragment.tone.duration - state.duration;
   if (remainingDuration > 0) {
     int points;
-    float toneIdx = state.idx;
+    uint32_t toneIdx = state.idx;
 
     if (fragment.tone.reset) {
       fragment.tone.reset = 0;
@@ -689,8 +885,9 @@ int ToneContext::mixBuffer(AudioBuffer * buffer, int volume, unsigned int fade)
 
     if (fragment.tone.freq != state.freq) {
       state.freq = fragment.tone.freq;
-      state.step = limit<float>(1, float(fragment.tone.freq) * (float(DIM(sineValues))/float(AUDIO_SAMPLE_RATE)), 512);
-      state.volume = 1.0f / evalVolumeRatio(fragment.tone.freq, volume);
+      state.step = limit<float>(1, float(fragment.tone.freq) * (float(DIM(sineValues))/float(AUDIO_SAMPLE_RATE)), 512) * 65536;
+      float ratio = evalVolumeRatio(fragment.tone.freq, volume);
+      state.volume = (ratio > 0.25f ? 4096 / ratio : 4 * 4096);
     }
 
     if (fragment.tone.freqIncr) {
@@ -718,21 +915,21 @@ int ToneContext::mixBuffer(AudioBuffer * buffer, int volume, unsigned int fade)
     else {
       duration = remainingDuration;
       points = (duration * AUDIO_BUFFER_SIZE) / AUDIO_BUFFER_DURATION;
-      unsigned int end = toneIdx + (state.step * points);
+      unsigned int end = (toneIdx + uint64_t(state.step) * points) >> 16;
       if (end > DIM(sineValues))
         end -= (end % DIM(sineValues));
       else
         end = DIM(sineValues);
-      points = (float(end) - toneIdx) / state.step;
+      points = ((uint64_t(end) << 16) - toneIdx) / state.step;
     }
 
     for (int i=0; i<points; i++) {
-      int16_t sample = sineValues[int(toneIdx)] * state.volume;
-      mixSample(&buffer->data[i], sample, fade);
+      mixBlock[i] = limit<int32_t>(INT16_MIN, (sineValues[toneIdx >> 16] * state.volume) >> 12, INT16_MAX);
       toneIdx += state.step;
-      if ((unsigned int)toneIdx >= DIM(sineValues))
-        toneIdx -= DIM(sineValues);
+      if (toneIdx >= (DIM(sineValues) << 16))
+        toneIdx -= (DIM(sineValues) << 16);
     }
+    mixSamples(buffer->data, mixBlock, points, fade);
 
     if (remainingDuration > AUDIO_BUFFER_DURATION) {
       state.duration += AUDIO_BUFFER_DURATION;
@@ -832,6 +1029,12 @@ void AudioQueue::wakeup()
     audioConsumeCurrentBuffer();
     DEBUG_TIMER_STOP(debugTimerAudioConsume);
   }
+
+#if defined(SDCARD)
+  // read the next sectors of the files while there is nothing else to do
+  normalContext.prefetch();
+  backgroundContext.prefetch();
+#endif
 }
 
 inline unsigned int getToneLength(uint16_t len)
@@ -949,6 +1152,7 @@ void AudioQueue::stopPlay(uint8_t id)
 void AudioQueue::stopSD()
 {
   sdAvailableSystemAudioFiles.reset();
+  memclear(wavHeadersCache, sizeof(wavHeadersCache));
   stopAll();
   playTone(0, 0, 100, PLAY_NOW);        // insert a 100ms pause
 }
@@ -73,6 +73,10 @@ template <unsigned int NUM_BITS> class BitField {
 #define AUDIO_BUFFER_DURATION          (10)
 #define AUDIO_BUFFER_SIZE              (AUDIO_SAMPLE_RATE*AUDIO_BUFFER_DURATION/1000)
 
+// the wav files are read ahead by whole SD sectors
+#define WAV_READ_CHUNK_SIZE            (512)
+#define WAV_READ_BUFFER_SIZE           (4*WAV_READ_CHUNK_SIZE)
+
 #if defined(SIMU) && defined(SIMU_AUDIO)
   #define AUDIO_BUFFER_COUNT           (10) // simulator needs more buffers for smooth audio
 #elif defined(PCBX12S)
@@ -116,7 +120,8 @@ enum AudioBufferState
   #define AUDIO_BITS_PER_SAMPLE        12
 #endif
 
-struct AudioBuffer {
+// word aligned, the samples are mixed 2 at a time
+struct __ALIGNED(4) AudioBuffer {
   audio_data_t data[AUDIO_BUFFER_SIZE];
   uint16_t size;
 #if defined(AUDIO_DUAL_BUFFER)
@@ -124,6 +129,8 @@ struct AudioBuffer {
 #endif
 };
 
+static_assert(sizeof(AudioBuffer) % 4 == 0, "the audio buffers have to be word aligned");
+
 extern AudioBuffer audioBuffers[AUDIO_BUFFER_COUNT];
 
 enum FragmentTypes {
@@ -199,9 +206,9 @@ class ToneContext {
     AudioFragment fragment;
 
     struct {
-      float step;
-      float idx;
-      float  volume;
+      uint32_t step;           // 16.16 fixed point
+      uint32_t idx;            // 16.16 fixed point
+      int32_t  volume;         // 4096 = 1.0
       uint16_t freq;
       uint16_t duration;
       uint16_t pause;
@@ -217,6 +224,9 @@ class WavContext {
     int mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade);
     bool hasPromptId(uint8_t id) const { return fragment.id == id; };
 
+    // fills the read buffer while the audio buffers are full
+    void prefetch();
+
     void setFragment(const char * filename, uint8_t repeat, uint8_t id)
     {
       fragment = AudioFragment(filename, repeat, id);
@@ -232,13 +242,20 @@ class WavContext {
   private:
     AudioFragment fragment;
 
+    FRESULT openFile();
+    FRESULT readAhead();
+
     struct {
       FIL      file;
       uint8_t  codec;
       uint32_t freq;
-      uint32_t size;
-      uint8_t  resampleRatio;
-      uint16_t readSize;
+      uint32_t size;           // samples bytes not read yet
+      uint32_t step;           // 16.16 fixed point step in the samples for each output sample
+      uint32_t position;       // 16.16 fixed point position in the first sample of the read buffer
+      // the read buffer mirrors the file offsets, so that each read ends on a sector boundary
+      uint16_t bufferStart;
+      uint16_t bufferCount;
+      uint8_t  buffer[WAV_READ_BUFFER_SIZE] __ALIGNED(4);
     } state;
 };
 
@@ -277,6 +294,11 @@ class MixedContext {
       return 0;
     }
 
+    void prefetch()
+    {
+      if (isFile()) wav.prefetch();
+    }
+
   private:
     union {
       AudioFragment fragment;   // a hack: fragment is used to access the fragment members of tone and wav
@@ -24,23 +24,144 @@
 #include "bin_allocator.h"
 
 
-BinAllocator_slots1 slots1;
-BinAllocator_slots2 slots2;
+BinAllocator::BinAllocator(char * slots, bool * used, unsigned int sizeSlot, unsigned int numBins):
+  Slots(slots),
+  Used(used),
+  SizeSlot(sizeSlot),
+  NumBins(numBins),
+  FirstFreeBin(0),
+  NoUsedBins(0),
+  MaxUsedBins(0),
+  Failures(0),
+  Fallbacks(0)
+{
+  memclear(used, numBins * sizeof(bool));
+  for (unsigned int n = 0; n < numBins; ++n) {
+    next_free(n) = (n + 1 < numBins ? n + 1 : NO_BIN);
+  }
+}
+
+bool BinAllocator::free(void * ptr)
+{
+  if (!is_member(ptr)) {
+    return false;
+  }
+  unsigned int offset = (char *)ptr - Slots;
+  if (offset % SizeSlot) {
+    return false;
+  }
+  unsigned int n = offset / SizeSlot;
+  if (!Used[n]) {
+    // still ours, it must not be given to the libc allocator
+    TRACE("BinAllocator<%d> double free %d", SizeSlot, n);
+    return true;
+  }
+  Used[n] = false;
+  next_free(n) = FirstFreeBin;
+  FirstFreeBin = n;
+  --NoUsedBins;
+  // TRACE("\tBinAllocator<%d> free %d ------", SizeSlot, n);
+  return true;
+}
+
+void * BinAllocator::malloc(size_t size)
+{
+  if (size > SizeSlot) {
+    // TRACE("BinAllocator<%d> malloc [%lu] size > SIZE_SLOT", SizeSlot, size);
+    return 0;
+  }
+  if (FirstFreeBin == NO_BIN) {
+    // TRACE("BinAllocator<%d> malloc [%lu] no free slots", SizeSlot, size);
+    ++Failures;
+    return 0;
+  }
+  unsigned int n = FirstFreeBin;
+  FirstFreeBin = next_free(n);
+  Used[n] = true;
+  if (++NoUsedBins > MaxUsedBins) {
+    MaxUsedBins = NoUsedBins;
+  }
+  // TRACE("\tBinAllocator<%d> malloc %d[%lu]", SizeSlot, n, size);
+  return Slots + n * SizeSlot;
+}
+
+#if defined(PCBHORUS) || defined(PCBNV14)
+// 416kB of the SDRAM, as the libc heap, but without the fragmentation
+BinAllocatorSlots<16, 4096> slots16 __SDRAM;
+BinAllocatorSlots<32, 4096> slots32 __SDRAM;
+BinAllocatorSlots<64, 2048> slots64 __SDRAM;
+BinAllocatorSlots<128, 512> slots128 __SDRAM;
+BinAllocatorSlots<256, 128> slots256 __SDRAM;
+#else
+BinAllocatorSlots<16, 128> slots16;
+BinAllocatorSlots<32, 96> slots32;
+BinAllocatorSlots<64, 40> slots64;
+BinAllocatorSlots<128, 12> slots128;
+BinAllocatorSlots<256, 4> slots256;
+#endif
+
+BinAllocator * const binAllocators[BIN_ALLOCATOR_CLASSES] = {
+  &slots16,
+  &slots32,
+  &slots64,
+  &slots128,
+  &slots256,
+};
+
+unsigned int binOversizeAllocations = 0;
+uint32_t binAllocatorHistogram[BIN_ALLOCATOR_HISTOGRAM_SIZE];
 
 #if defined(DEBUG)
 int SimulateMallocFailure = 0;    //set this to simulate allocation failure
 #endif 
 
+BinAllocator * bin_owner(void * ptr)
+{
+  for (uint8_t i = 0; i < BIN_ALLOCATOR_CLASSES; i++) {
+    if (binAllocators[i]->is_member(ptr)) {
+      return binAllocators[i];
+    }
+  }
+  return NULL;
+}
+
 bool bin_free(void * ptr)
 {
   //return TRUE if ours
-  return slots1.free(ptr) || slots2.free(ptr);
+  BinAllocator * allocator = bin_owner(ptr);
+  return allocator && allocator->free(ptr);
 }
 
-void * bin_malloc(size_t size) {
-  //try to allocate from our space
-  void * res = slots1.malloc(size);
-  return res ? res : slots2.malloc(size);
+void * bin_malloc(size_t size)
+{
+  //try the smallest slot size which fits, then the bigger ones
+  for (uint8_t i = 0; i < BIN_ALLOCATOR_CLASSES; i++) {
+    if (size <= binAllocators[i]->slot_size()) {
+      void * res = binAllocators[i]->malloc(size);
+      if (res) {
+        return res;
+      }
+    }
+  }
+  return 0;
+}
+
+// accounts an allocation which had to be done by the libc allocator
+void bin_fallback(size_t size)
+{
+  for (uint8_t i = 0; i < BIN_ALLOCATOR_CLASSES; i++) {
+    if (size <= binAllocators[i]->slot_size()) {
+      binAllocators[i]->fallback();
+      return;
+    }
+  }
+  binOversizeAllocations++;
+}
+
+void bin_record(size_t size)
+{
+  unsigned int index = (size - 1) / BIN_ALLOCATOR_HISTOGRAM_STEP;
+  binAllocatorHistogram[min<unsigned int>(index, BIN_ALLOCATOR_HISTOGRAM_SIZE - 1)]++;
 }
 
 void * bin_realloc(void * ptr, size_t size)
@@ -50,7 +171,8 @@ void * bin_realloc(void * ptr, size_t size)
     return bin_malloc(size);
   }
   else {
-    if (! (slots1.is_member(ptr) || slots2.is_member(ptr)) ) {
+    BinAllocator * allocator = bin_owner(ptr);
+    if (!allocator) {
       // not our data, leave it to libc realloc
       return 0;
     }
@@ -58,12 +180,8 @@ void * bin_realloc(void * ptr, size_t size)
     //we have existing data
     // if it fits in current slot, return it
     // TODO if new size is smaller, try to relocate in smaller slot
-    if ( slots1.can_fit(ptr, size) ) {
-      // TRACE("OUR realloc %p[%lu] fits in slot1", ptr, size);
-      return ptr;
-    }
-    if ( slots2.can_fit(ptr, size) ) {
-      // TRACE("OUR realloc %p[%lu] fits in slot2", ptr, size);
+    if (allocator->can_fit(ptr, size)) {
+      // TRACE("OUR realloc %p[%lu] fits", ptr, size);
       return ptr;
     }
 
@@ -72,6 +190,7 @@ void * bin_realloc(void * ptr, size_t size)
     if (res == 0) {
       // we don't have the space, use libc malloc
       // TRACE("bin_malloc [%lu] FAILURE", size);
+      bin_fallback(size);
       res = malloc(size);
       if (res == 0) {
         TRACE("libc malloc [%lu] FAILURE", size);  
@@ -79,8 +198,8 @@ void * bin_realloc(void * ptr, size_t size)
       }
     }
     //copy data
-    memcpy(res, ptr, slots1.size(ptr) + slots2.size(ptr));
-    bin_free(ptr);
+    memcpy(res, ptr, allocator->size(ptr));
+    allocator->free(ptr);
     return res;
   }
 }
@@ -114,11 +233,16 @@ void *bin_l_alloc (void *ud, void *ptr, size_t osize, size_t nsize)
     }
 #endif // #if defined(DEBUG)
     // try our allocator, if it fails use libc allocator
+    bin_record(nsize);
     void * res = bin_realloc(ptr, nsize);
     if (res && ptr) {
       // TRACE("OUR realloc %p[%lu] -> %p[%lu]", ptr, osize, res, nsize); 
     }
-    if (res == 0) {
+    if (res == 0 && !bin_owner(ptr)) {
+      // our slots are never given to libc realloc
+      if (ptr == 0) {
+        bin_fallback(nsize);
+      }
       res = realloc(ptr, nsize);
       // TRACE("libc realloc %p[%lu] -> %p[%lu]", ptr, osize, res, nsize);
       // if (res == 0 ){
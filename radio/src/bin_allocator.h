@@ -21,75 +21,75 @@
 #ifndef _BIN_ALLOCATOR_H_
 #define _BIN_ALLOCATOR_H_
 
+#include <string.h>
 #include "debug.h"
 
-template <int SIZE_SLOT, int NUM_BINS> class BinAllocator {
-private:
-  PACK(struct Bin {
-    char data[SIZE_SLOT];
-    bool Used;
-  });
-  struct Bin Bins[NUM_BINS];
-  int NoUsedBins;
+// Fixed size slots allocator: the free bins are chained through their own
+// data area (the index of the next free bin is stored there), so malloc() and
+// free() don't have to scan the bins.
+class BinAllocator {
 public:
-  BinAllocator() : NoUsedBins(0) {
-    memclear(Bins, sizeof(Bins));
-  }
-  bool free(void * ptr) {
-    for (size_t n = 0; n < NUM_BINS; ++n) {
-      if (ptr == Bins[n].data) {
-        Bins[n].Used = false;
-        --NoUsedBins;
-        // TRACE("\tBinAllocator<%d> free %lu ------", SIZE_SLOT, n);
-        return true;
-      }
-    }
-    return false;
-  }
+  bool free(void * ptr);
+  void * malloc(size_t size);
   bool is_member(void * ptr) {
-    return (ptr >= Bins[0].data && ptr <= Bins[NUM_BINS-1].data);
-  }
-  void * malloc(size_t size) {
-    if (size > SIZE_SLOT) {
-      // TRACE("BinAllocator<%d> malloc [%lu] size > SIZE_SLOT", SIZE_SLOT, size);
-      return 0;
-    }
-    if (NoUsedBins >= NUM_BINS) {
-      // TRACE("BinAllocator<%d> malloc [%lu] no free slots", SIZE_SLOT, size);
-      return 0;
-    }
-    for (size_t n = 0; n < NUM_BINS; ++n) {
-      if (!Bins[n].Used) {
-        Bins[n].Used = true;
-        ++NoUsedBins;
-        // TRACE("\tBinAllocator<%d> malloc %lu[%lu]", SIZE_SLOT, n, size);
-        return Bins[n].data;
-      }
-    }
-    // TRACE("BinAllocator<%d> malloc [%lu] no free slots", SIZE_SLOT , size);
-    return 0;
+    return (ptr >= Slots && ptr < Slots + SizeSlot * NumBins);
   }
   size_t size(void * ptr) {
-    return is_member(ptr) ? SIZE_SLOT : 0;
+    return is_member(ptr) ? SizeSlot : 0;
   }
   bool can_fit(void * ptr, size_t size) {
-    return is_member(ptr) && size <= SIZE_SLOT;  //todo is_member check is redundant
+    return is_member(ptr) && size <= SizeSlot;
   }
-  unsigned int capacity() { return NUM_BINS; }
+  // called when an allocation of this slot size had to be done by the libc allocator
+  void fallback() { ++Fallbacks; }
+  unsigned int slot_size() { return SizeSlot; }
+  unsigned int capacity() { return NumBins; }
   unsigned int size() { return NoUsedBins; }
+  unsigned int high_water_mark() { return MaxUsedBins; }
+  unsigned int failures() { return Failures; }
+  unsigned int fallbacks() { return Fallbacks; }
+protected:
+  // slots and used may be in a NOLOAD section (SDRAM), they are initialized here
+  BinAllocator(char * slots, bool * used, unsigned int sizeSlot, unsigned int numBins);
+private:
+  enum { NO_BIN = 0xFFFF };
+  char * Slots;
+  bool * Used;
+  uint16_t SizeSlot;
+  uint16_t NumBins;
+  uint16_t FirstFreeBin;
+  uint16_t NoUsedBins;
+  // statistics
+  uint16_t MaxUsedBins;
+  unsigned int Failures;
+  unsigned int Fallbacks;
+  uint16_t & next_free(unsigned int n) {
+    return *(uint16_t *)(Slots + n * SizeSlot);
+  }
 };
 
-#if defined(SIMU)
-typedef BinAllocator<39,300> BinAllocator_slots1;
-typedef BinAllocator<79,100> BinAllocator_slots2;
-#else
-typedef BinAllocator<29,200> BinAllocator_slots1;
-typedef BinAllocator<91,50> BinAllocator_slots2;
-#endif
+// The storage of one slab class, slots are 8 bytes aligned as Lua expects from malloc()
+template <int SIZE_SLOT, int NUM_BINS> class BinAllocatorSlots: public BinAllocator {
+public:
+  BinAllocatorSlots() : BinAllocator(&Storage[0][0], UsedBins, SIZE_SLOT, NUM_BINS) {
+  }
+private:
+  char Storage[NUM_BINS][SIZE_SLOT] __ALIGNED(8);
+  bool UsedBins[NUM_BINS];
+};
 
 #if defined(USE_BIN_ALLOCATOR)
-extern BinAllocator_slots1 slots1;
-extern BinAllocator_slots2 slots2;
+// the slab classes, by increasing slot size
+#define BIN_ALLOCATOR_CLASSES          5
+extern BinAllocator * const binAllocators[BIN_ALLOCATOR_CLASSES];
+
+// allocations of a size above all the slot sizes, always done by the libc allocator
+extern unsigned int binOversizeAllocations;
+
+// histogram of the Lua allocation sizes, used to tune the slab classes
+#define BIN_ALLOCATOR_HISTOGRAM_STEP   16
+#define BIN_ALLOCATOR_HISTOGRAM_SIZE   33 // the last one counts the allocations above 512 bytes
+extern uint32_t binAllocatorHistogram[BIN_ALLOCATOR_HISTOGRAM_SIZE];
 
 // wrapper for our BinAllocator for Lua
 void *bin_l_alloc (void *ud, void *ptr, size_t osize, size_t nsize);
@@ -20,6 +20,8 @@
 
 #include "opentx.h"
 #include "diskio.h"
+#include "bin_allocator.h"
+#include "mixer_timings.h"
 #include <ctype.h>
 #include <malloc.h>
 #include <new>
@@ -724,6 +726,9 @@ int cliStackInfo(const char ** argv)
   serialPrint("[MIXER] %d available / %d", mixerStack.available(), mixerStack.size());
   serialPrint("[AUDIO] %d available / %d", audioStack.available(), audioStack.size());
   serialPrint("[CLI] %d available / %d", cliStack.available(), cliStack.size());
+#if defined(LOG_BINARY)
+  serialPrint("[LOGS] %d available / %d", logsStack.available(), logsStack.size());
+#endif
   return 0;
 }
 
@@ -772,6 +777,68 @@ int cliMemoryInfo(const char ** argv)
   serialPrint("------------");
   serialPrint("\tTotal   %u", s + w + e);
 #endif
+#if defined(USE_BIN_ALLOCATOR)
+  serialPrint("\nBin allocator:");
+  for (uint8_t i=0; i<BIN_ALLOCATOR_CLASSES; i++) {
+    BinAllocator * allocator = binAllocators[i];
+    serialPrint("\t%3u bytes: %u used / %u, max %u, failed %u, libc %u", allocator->slot_size(), allocator->size(), allocator->capacity(), allocator->high_water_mark(), allocator->failures(), allocator->fallbacks());
+  }
+  serialPrint("\toversize libc %u", binOversizeAllocations);
+#endif
+#endif
+  return 0;
+}
+
+#if defined(USE_BIN_ALLOCATOR)
+int cliAllocHistogram(const char ** argv)
+{
+  if (!strcmp(argv[1], "reset")) {
+    memclear(binAllocatorHistogram, sizeof(binAllocatorHistogram));
+    return 0;
+  }
+  for (uint8_t i=0; i<BIN_ALLOCATOR_HISTOGRAM_SIZE-1; i++) {
+    if (binAllocatorHistogram[i]) {
+      serialPrint("%3d..%3d bytes: %u", i*BIN_ALLOCATOR_HISTOGRAM_STEP + 1, (i+1)*BIN_ALLOCATOR_HISTOGRAM_STEP, binAllocatorHistogram[i]);
+    }
+  }
+  serialPrint("   > %3d bytes: %u", (BIN_ALLOCATOR_HISTOGRAM_SIZE-1)*BIN_ALLOCATOR_HISTOGRAM_STEP, binAllocatorHistogram[BIN_ALLOCATOR_HISTOGRAM_SIZE-1]);
+  return 0;
+}
+#endif
+
+static void cliPrintTimingHistogram(const char * name, const TimingHistogram & histogram)
+{
+  serialPrint("%s: %u samples, min %uus, avg %uus, p99 %uus, max %uus", name, histogram.getCount(), histogram.getMin(), histogram.getAvg(), histogram.getPercentile(99), histogram.getMax());
+  uint32_t width = histogram.getBucketWidth();
+  for (uint8_t j=0; j<TIMING_HISTOGRAM_BUCKETS-1; j++) {
+    if (histogram.getBucket(j)) {
+      serialPrint("\t%4u..%4uus: %u", j*width, (j+1)*width - 1, histogram.getBucket(j));
+    }
+  }
+  if (histogram.getBucket(TIMING_HISTOGRAM_BUCKETS-1)) {
+    serialPrint("\t    >=%4uus: %u", (TIMING_HISTOGRAM_BUCKETS-1)*width, histogram.getBucket(TIMING_HISTOGRAM_BUCKETS-1));
+  }
+}
+
+int cliMixerTimings(const char ** argv)
+{
+  if (!strcmp(argv[1], "reset")) {
+    mixerTimingsReset();
+#if defined(TELEMETRY_RX_EVENTS)
+    telemetryLatencyReset();
+#endif
+    return 0;
+  }
+  for (uint8_t i=0; i<MIXER_TIMINGS_COUNT; i++) {
+    cliPrintTimingHistogram(mixerTimingNames[i], mixerTimings[i]);
+  }
+#if defined(TELEMETRY_RX_EVENTS)
+  // telemetry frames latency, only the protocols which received frames
+  for (uint8_t i=0; i<=PROTOCOL_TELEMETRY_LAST; i++) {
+    if (telemetryLatency[i].getCount()) {
+      cliPrintTimingHistogram(telemetryProtocolNames[i], telemetryLatency[i]);
+    }
+  }
 #endif
   return 0;
 }
@@ -1089,6 +1156,7 @@ int cliDisplay(const char ** argv)
     DiskCacheStats stats = diskCache.getStats();
     uint32_t hitRate = diskCache.getHitRate();
     serialPrint("Disk Cache stats: w:%u r: %u, h: %u(%0.1f%%), m: %u", stats.noWrites, (stats.noHits + stats.noMisses), stats.noHits, hitRate*0.1f, stats.noMisses);
+    serialPrint("  evictions: %u, read-ahead: %u (used %u), write-back: %u, flushes: %u", stats.noEvictions, stats.noReadAheads, stats.noReadAheadHits, stats.noWriteBacks, stats.noFlushes);
   }
 #endif
   else if (toLongLongInt(argv, 1, &address) > 0) {
@@ -1221,6 +1289,10 @@ const CliCommand cliCommands[] = {
   { "set", cliSet, "<what> <value>" },
   { "stackinfo", cliStackInfo, "" },
   { "meminfo", cliMemoryInfo, "" },
+#if defined(USE_BIN_ALLOCATOR)
+  { "allochist", cliAllocHistogram, "[reset]" },
+#endif
+  { "timings", cliMixerTimings, "[reset]" },
   { "test", cliTest, "new | std::exception | graphics | memspd" },
 #if defined(DEBUG)
   { "trace", cliTrace, "on | off" },
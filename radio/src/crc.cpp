@@ -18,17 +18,313 @@
  * GNU General Public License for more details.
  */
 
+#include <string.h>
 #include "crc.h"
 
-static const unsigned short * crc16tab[] = {
+// CRC16 implementation according to CCITT standards
+const uint16_t crc16tab_1021[256] = {
+  0x0000,0x1021,0x2042,0x3063,0x4084,0x50a5,0x60c6,0x70e7,
+  0x8108,0x9129,0xa14a,0xb16b,0xc18c,0xd1ad,0xe1ce,0xf1ef,
+  0x1231,0x0210,0x3273,0x2252,0x52b5,0x4294,0x72f7,0x62d6,
+  0x9339,0x8318,0xb37b,0xa35a,0xd3bd,0xc39c,0xf3ff,0xe3de,
+  0x2462,0x3443,0x0420,0x1401,0x64e6,0x74c7,0x44a4,0x5485,
+  0xa56a,0xb54b,0x8528,0x9509,0xe5ee,0xf5cf,0xc5ac,0xd58d,
+  0x3653,0x2672,0x1611,0x0630,0x76d7,0x66f6,0x5695,0x46b4,
+  0xb75b,0xa77a,0x9719,0x8738,0xf7df,0xe7fe,0xd79d,0xc7bc,
+  0x48c4,0x58e5,0x6886,0x78a7,0x0840,0x1861,0x2802,0x3823,
+  0xc9cc,0xd9ed,0xe98e,0xf9af,0x8948,0x9969,0xa90a,0xb92b,
+  0x5af5,0x4ad4,0x7ab7,0x6a96,0x1a71,0x0a50,0x3a33,0x2a12,
+  0xdbfd,0xcbdc,0xfbbf,0xeb9e,0x9b79,0x8b58,0xbb3b,0xab1a,
+  0x6ca6,0x7c87,0x4ce4,0x5cc5,0x2c22,0x3c03,0x0c60,0x1c41,
+  0xedae,0xfd8f,0xcdec,0xddcd,0xad2a,0xbd0b,0x8d68,0x9d49,
+  0x7e97,0x6eb6,0x5ed5,0x4ef4,0x3e13,0x2e32,0x1e51,0x0e70,
+  0xff9f,0xefbe,0xdfdd,0xcffc,0xbf1b,0xaf3a,0x9f59,0x8f78,
+  0x9188,0x81a9,0xb1ca,0xa1eb,0xd10c,0xc12d,0xf14e,0xe16f,
+  0x1080,0x00a1,0x30c2,0x20e3,0x5004,0x4025,0x7046,0x6067,
+  0x83b9,0x9398,0xa3fb,0xb3da,0xc33d,0xd31c,0xe37f,0xf35e,
+  0x02b1,0x1290,0x22f3,0x32d2,0x4235,0x5214,0x6277,0x7256,
+  0xb5ea,0xa5cb,0x95a8,0x8589,0xf56e,0xe54f,0xd52c,0xc50d,
+  0x34e2,0x24c3,0x14a0,0x0481,0x7466,0x6447,0x5424,0x4405,
+  0xa7db,0xb7fa,0x8799,0x97b8,0xe75f,0xf77e,0xc71d,0xd73c,
+  0x26d3,0x36f2,0x0691,0x16b0,0x6657,0x7676,0x4615,0x5634,
+  0xd94c,0xc96d,0xf90e,0xe92f,0x99c8,0x89e9,0xb98a,0xa9ab,
+  0x5844,0x4865,0x7806,0x6827,0x18c0,0x08e1,0x3882,0x28a3,
+  0xcb7d,0xdb5c,0xeb3f,0xfb1e,0x8bf9,0x9bd8,0xabbb,0xbb9a,
+  0x4a75,0x5a54,0x6a37,0x7a16,0x0af1,0x1ad0,0x2ab3,0x3a92,
+  0xfd2e,0xed0f,0xdd6c,0xcd4d,0xbdaa,0xad8b,0x9de8,0x8dc9,
+  0x7c26,0x6c07,0x5c64,0x4c45,0x3ca2,0x2c83,0x1ce0,0x0cc1,
+  0xef1f,0xff3e,0xcf5d,0xdf7c,0xaf9b,0xbfba,0x8fd9,0x9ff8,
+  0x6e17,0x7e36,0x4e55,0x5e74,0x2e93,0x3eb2,0x0ed1,0x1ef0
+};
+
+const uint16_t crc16tab_1189[256] = {
+  0x0000,0x1189,0x2312,0x329b,0x4624,0x57ad,0x6536,0x74bf,
+  0x8c48,0x9dc1,0xaf5a,0xbed3,0xca6c,0xdbe5,0xe97e,0xf8f7,
+  0x1081,0x0108,0x3393,0x221a,0x56a5,0x472c,0x75b7,0x643e,
+  0x9cc9,0x8d40,0xbfdb,0xae52,0xdaed,0xcb64,0xf9ff,0xe876,
+  0x2102,0x308b,0x0210,0x1399,0x6726,0x76af,0x4434,0x55bd,
+  0xad4a,0xbcc3,0x8e58,0x9fd1,0xeb6e,0xfae7,0xc87c,0xd9f5,
+  0x3183,0x200a,0x1291,0x0318,0x77a7,0x662e,0x54b5,0x453c,
+  0xbdcb,0xac42,0x9ed9,0x8f50,0xfbef,0xea66,0xd8fd,0xc974,
+  0x4204,0x538d,0x6116,0x709f,0x0420,0x15a9,0x2732,0x36bb,
+  0xce4c,0xdfc5,0xed5e,0xfcd7,0x8868,0x99e1,0xab7a,0xbaf3,
+  0x5285,0x430c,0x7197,0x601e,0x14a1,0x0528,0x37b3,0x263a,
+  0xdecd,0xcf44,0xfddf,0xec56,0x98e9,0x8960,0xbbfb,0xaa72,
+  0x6306,0x728f,0x4014,0x519d,0x2522,0x34ab,0x0630,0x17b9,
+  0xef4e,0xfec7,0xcc5c,0xddd5,0xa96a,0xb8e3,0x8a78,0x9bf1,
+  0x7387,0x620e,0x5095,0x411c,0x35a3,0x242a,0x16b1,0x0738,
+  0xffcf,0xee46,0xdcdd,0xcd54,0xb9eb,0xa862,0x9af9,0x8b70,
+  0x8408,0x9581,0xa71a,0xb693,0xc22c,0xd3a5,0xe13e,0xf0b7,
+  0x0840,0x19c9,0x2b52,0x3adb,0x4e64,0x5fed,0x6d76,0x7cff,
+  0x9489,0x8500,0xb79b,0xa612,0xd2ad,0xc324,0xf1bf,0xe036,
+  0x18c1,0x0948,0x3bd3,0x2a5a,0x5ee5,0x4f6c,0x7df7,0x6c7e,
+  0xa50a,0xb483,0x8618,0x9791,0xe32e,0xf2a7,0xc03c,0xd1b5,
+  0x2942,0x38cb,0x0a50,0x1bd9,0x6f66,0x7eef,0x4c74,0x5dfd,
+  0xb58b,0xa402,0x9699,0x8710,0xf3af,0xe226,0xd0bd,0xc134,
+  0x39c3,0x284a,0x1ad1,0x0b58,0x7fe7,0x6e6e,0x5cf5,0x4d7c,
+  0xc60c,0xd785,0xe51e,0xf497,0x8028,0x91a1,0xa33a,0xb2b3,
+  0x4a44,0x5bcd,0x6956,0x78df,0x0c60,0x1de9,0x2f72,0x3efb,
+  0xd68d,0xc704,0xf59f,0xe416,0x90a9,0x8120,0xb3bb,0xa232,
+  0x5ac5,0x4b4c,0x79d7,0x685e,0x1ce1,0x0d68,0x3ff3,0x2e7a,
+  0xe70e,0xf687,0xc41c,0xd595,0xa12a,0xb0a3,0x8238,0x93b1,
+  0x6b46,0x7acf,0x4854,0x59dd,0x2d62,0x3ceb,0x0e70,0x1ff9,
+  0xf78f,0xe606,0xd49d,0xc514,0xb1ab,0xa022,0x92b9,0x8330,
+  0x7bc7,0x6a4e,0x58d5,0x495c,0x3de3,0x2c6a,0x1ef1,0x0f78
+};
+
+// The same tables advanced by 1, 2 and 3 more bytes, which gives the CRC of 4
+// bytes with 4 independent lookups (slice-by-4)
+static const uint16_t crc16tab_1021_slices[3][256] = {
+  {
+    0x0000,0x3331,0x6662,0x5553,0xccc4,0xfff5,0xaaa6,0x9997,
+    0x89a9,0xba98,0xefcb,0xdcfa,0x456d,0x765c,0x230f,0x103e,
+    0x0373,0x3042,0x6511,0x5620,0xcfb7,0xfc86,0xa9d5,0x9ae4,
+    0x8ada,0xb9eb,0xecb8,0xdf89,0x461e,0x752f,0x207c,0x134d,
+    0x06e6,0x35d7,0x6084,0x53b5,0xca22,0xf913,0xac40,0x9f71,
+    0x8f4f,0xbc7e,0xe92d,0xda1c,0x438b,0x70ba,0x25e9,0x16d8,
+    0x0595,0x36a4,0x63f7,0x50c6,0xc951,0xfa60,0xaf33,0x9c02,
+    0x8c3c,0xbf0d,0xea5e,0xd96f,0x40f8,0x73c9,0x269a,0x15ab,
+    0x0dcc,0x3efd,0x6bae,0x589f,0xc108,0xf239,0xa76a,0x945b,
+    0x8465,0xb754,0xe207,0xd136,0x48a1,0x7b90,0x2ec3,0x1df2,
+    0x0ebf,0x3d8e,0x68dd,0x5bec,0xc27b,0xf14a,0xa419,0x9728,
+    0x8716,0xb427,0xe174,0xd245,0x4bd2,0x78e3,0x2db0,0x1e81,
+    0x0b2a,0x381b,0x6d48,0x5e79,0xc7ee,0xf4df,0xa18c,0x92bd,
+    0x8283,0xb1b2,0xe4e1,0xd7d0,0x4e47,0x7d76,0x2825,0x1b14,
+    0x0859,0x3b68,0x6e3b,0x5d0a,0xc49d,0xf7ac,0xa2ff,0x91ce,
+    0x81f0,0xb2c1,0xe792,0xd4a3,0x4d34,0x7e05,0x2b56,0x1867,
+    0x1b98,0x28a9,0x7dfa,0x4ecb,0xd75c,0xe46d,0xb13e,0x820f,
+    0x9231,0xa100,0xf453,0xc762,0x5ef5,0x6dc4,0x3897,0x0ba6,
+    0x18eb,0x2bda,0x7e89,0x4db8,0xd42f,0xe71e,0xb24d,0x817c,
+    0x9142,0xa273,0xf720,0xc411,0x5d86,0x6eb7,0x3be4,0x08d5,
+    0x1d7e,0x2e4f,0x7b1c,0x482d,0xd1ba,0xe28b,0xb7d8,0x84e9,
+    0x94d7,0xa7e6,0xf2b5,0xc184,0x5813,0x6b22,0x3e71,0x0d40,
+    0x1e0d,0x2d3c,0x786f,0x4b5e,0xd2c9,0xe1f8,0xb4ab,0x879a,
+    0x97a4,0xa495,0xf1c6,0xc2f7,0x5b60,0x6851,0x3d02,0x0e33,
+    0x1654,0x2565,0x7036,0x4307,0xda90,0xe9a1,0xbcf2,0x8fc3,
+    0x9ffd,0xaccc,0xf99f,0xcaae,0x5339,0x6008,0x355b,0x066a,
+    0x1527,0x2616,0x7345,0x4074,0xd9e3,0xead2,0xbf81,0x8cb0,
+    0x9c8e,0xafbf,0xfaec,0xc9dd,0x504a,0x637b,0x3628,0x0519,
+    0x10b2,0x2383,0x76d0,0x45e1,0xdc76,0xef47,0xba14,0x8925,
+    0x991b,0xaa2a,0xff79,0xcc48,0x55df,0x66ee,0x33bd,0x008c,
+    0x13c1,0x20f0,0x75a3,0x4692,0xdf05,0xec34,0xb967,0x8a56,
+    0x9a68,0xa959,0xfc0a,0xcf3b,0x56ac,0x659d,0x30ce,0x03ff
+  },
+  {
+    0x0000,0x3730,0x6e60,0x5950,0xdcc0,0xebf0,0xb2a0,0x8590,
+    0xa9a1,0x9e91,0xc7c1,0xf0f1,0x7561,0x4251,0x1b01,0x2c31,
+    0x4363,0x7453,0x2d03,0x1a33,0x9fa3,0xa893,0xf1c3,0xc6f3,
+    0xeac2,0xddf2,0x84a2,0xb392,0x3602,0x0132,0x5862,0x6f52,
+    0x86c6,0xb1f6,0xe8a6,0xdf96,0x5a06,0x6d36,0x3466,0x0356,
+    0x2f67,0x1857,0x4107,0x7637,0xf3a7,0xc497,0x9dc7,0xaaf7,
+    0xc5a5,0xf295,0xabc5,0x9cf5,0x1965,0x2e55,0x7705,0x4035,
+    0x6c04,0x5b34,0x0264,0x3554,0xb0c4,0x87f4,0xdea4,0xe994,
+    0x1dad,0x2a9d,0x73cd,0x44fd,0xc16d,0xf65d,0xaf0d,0x983d,
+    0xb40c,0x833c,0xda6c,0xed5c,0x68cc,0x5ffc,0x06ac,0x319c,
+    0x5ece,0x69fe,0x30ae,0x079e,0x820e,0xb53e,0xec6e,0xdb5e,
+    0xf76f,0xc05f,0x990f,0xae3f,0x2baf,0x1c9f,0x45cf,0x72ff,
+    0x9b6b,0xac5b,0xf50b,0xc23b,0x47ab,0x709b,0x29cb,0x1efb,
+    0x32ca,0x05fa,0x5caa,0x6b9a,0xee0a,0xd93a,0x806a,0xb75a,
+    0xd808,0xef38,0xb668,0x8158,0x04c8,0x33f8,0x6aa8,0x5d98,
+    0x71a9,0x4699,0x1fc9,0x28f9,0xad69,0x9a59,0xc309,0xf439,
+    0x3b5a,0x0c6a,0x553a,0x620a,0xe79a,0xd0aa,0x89fa,0xbeca,
+    0x92fb,0xa5cb,0xfc9b,0xcbab,0x4e3b,0x790b,0x205b,0x176b,
+    0x7839,0x4f09,0x1659,0x2169,0xa4f9,0x93c9,0xca99,0xfda9,
+    0xd198,0xe6a8,0xbff8,0x88c8,0x0d58,0x3a68,0x6338,0x5408,
+    0xbd9c,0x8aac,0xd3fc,0xe4cc,0x615c,0x566c,0x0f3c,0x380c,
+    0x143d,0x230d,0x7a5d,0x4d6d,0xc8fd,0xffcd,0xa69d,0x91ad,
+    0xfeff,0xc9cf,0x909f,0xa7af,0x223f,0x150f,0x4c5f,0x7b6f,
+    0x575e,0x606e,0x393e,0x0e0e,0x8b9e,0xbcae,0xe5fe,0xd2ce,
+    0x26f7,0x11c7,0x4897,0x7fa7,0xfa37,0xcd07,0x9457,0xa367,
+    0x8f56,0xb866,0xe136,0xd606,0x5396,0x64a6,0x3df6,0x0ac6,
+    0x6594,0x52a4,0x0bf4,0x3cc4,0xb954,0x8e64,0xd734,0xe004,
+    0xcc35,0xfb05,0xa255,0x9565,0x10f5,0x27c5,0x7e95,0x49a5,
+    0xa031,0x9701,0xce51,0xf961,0x7cf1,0x4bc1,0x1291,0x25a1,
+    0x0990,0x3ea0,0x67f0,0x50c0,0xd550,0xe260,0xbb30,0x8c00,
+    0xe352,0xd462,0x8d32,0xba02,0x3f92,0x08a2,0x51f2,0x66c2,
+    0x4af3,0x7dc3,0x2493,0x13a3,0x9633,0xa103,0xf853,0xcf63
+  },
+  {
+    0x0000,0x76b4,0xed68,0x9bdc,0xcaf1,0xbc45,0x2799,0x512d,
+    0x85c3,0xf377,0x68ab,0x1e1f,0x4f32,0x3986,0xa25a,0xd4ee,
+    0x1ba7,0x6d13,0xf6cf,0x807b,0xd156,0xa7e2,0x3c3e,0x4a8a,
+    0x9e64,0xe8d0,0x730c,0x05b8,0x5495,0x2221,0xb9fd,0xcf49,
+    0x374e,0x41fa,0xda26,0xac92,0xfdbf,0x8b0b,0x10d7,0x6663,
+    0xb28d,0xc439,0x5fe5,0x2951,0x787c,0x0ec8,0x9514,0xe3a0,
+    0x2ce9,0x5a5d,0xc181,0xb735,0xe618,0x90ac,0x0b70,0x7dc4,
+    0xa92a,0xdf9e,0x4442,0x32f6,0x63db,0x156f,0x8eb3,0xf807,
+    0x6e9c,0x1828,0x83f4,0xf540,0xa46d,0xd2d9,0x4905,0x3fb1,
+    0xeb5f,0x9deb,0x0637,0x7083,0x21ae,0x571a,0xccc6,0xba72,
+    0x753b,0x038f,0x9853,0xeee7,0xbfca,0xc97e,0x52a2,0x2416,
+    0xf0f8,0x864c,0x1d90,0x6b24,0x3a09,0x4cbd,0xd761,0xa1d5,
+    0x59d2,0x2f66,0xb4ba,0xc20e,0x9323,0xe597,0x7e4b,0x08ff,
+    0xdc11,0xaaa5,0x3179,0x47cd,0x16e0,0x6054,0xfb88,0x8d3c,
+    0x4275,0x34c1,0xaf1d,0xd9a9,0x8884,0xfe30,0x65ec,0x1358,
+    0xc7b6,0xb102,0x2ade,0x5c6a,0x0d47,0x7bf3,0xe02f,0x969b,
+    0xdd38,0xab8c,0x3050,0x46e4,0x17c9,0x617d,0xfaa1,0x8c15,
+    0x58fb,0x2e4f,0xb593,0xc327,0x920a,0xe4be,0x7f62,0x09d6,
+    0xc69f,0xb02b,0x2bf7,0x5d43,0x0c6e,0x7ada,0xe106,0x97b2,
+    0x435c,0x35e8,0xae34,0xd880,0x89ad,0xff19,0x64c5,0x1271,
+    0xea76,0x9cc2,0x071e,0x71aa,0x2087,0x5633,0xcdef,0xbb5b,
+    0x6fb5,0x1901,0x82dd,0xf469,0xa544,0xd3f0,0x482c,0x3e98,
+    0xf1d1,0x8765,0x1cb9,0x6a0d,0x3b20,0x4d94,0xd648,0xa0fc,
+    0x7412,0x02a6,0x997a,0xefce,0xbee3,0xc857,0x538b,0x253f,
+    0xb3a4,0xc510,0x5ecc,0x2878,0x7955,0x0fe1,0x943d,0xe289,
+    0x3667,0x40d3,0xdb0f,0xadbb,0xfc96,0x8a22,0x11fe,0x674a,
+    0xa803,0xdeb7,0x456b,0x33df,0x62f2,0x1446,0x8f9a,0xf92e,
+    0x2dc0,0x5b74,0xc0a8,0xb61c,0xe731,0x9185,0x0a59,0x7ced,
+    0x84ea,0xf25e,0x6982,0x1f36,0x4e1b,0x38af,0xa373,0xd5c7,
+    0x0129,0x779d,0xec41,0x9af5,0xcbd8,0xbd6c,0x26b0,0x5004,
+    0x9f4d,0xe9f9,0x7225,0x0491,0x55bc,0x2308,0xb8d4,0xce60,
+    0x1a8e,0x6c3a,0xf7e6,0x8152,0xd07f,0xa6cb,0x3d17,0x4ba3
+  }
+};
+
+static const uint16_t crc16tab_1189_slices[3][256] = {
+  {
+    0x0000,0x8808,0x0199,0x8991,0x0332,0x8b3a,0x02ab,0x8aa3,
+    0x0664,0x8e6c,0x07fd,0x8ff5,0x0556,0x8d5e,0x04cf,0x8cc7,
+    0x9181,0x1989,0x9018,0x1810,0x92b3,0x1abb,0x932a,0x1b22,
+    0x97e5,0x1fed,0x967c,0x1e74,0x94d7,0x1cdf,0x954e,0x1d46,
+    0x328b,0xba83,0x3312,0xbb1a,0x31b9,0xb9b1,0x3020,0xb828,
+    0x34ef,0xbce7,0x3576,0xbd7e,0x37dd,0xbfd5,0x3644,0xbe4c,
+    0xa30a,0x2b02,0xa293,0x2a9b,0xa038,0x2830,0xa1a1,0x29a9,
+    0xa56e,0x2d66,0xa4f7,0x2cff,0xa65c,0x2e54,0xa7c5,0x2fcd,
+    0x6516,0xed1e,0x648f,0xec87,0x6624,0xee2c,0x67bd,0xefb5,
+    0x6372,0xeb7a,0x62eb,0xeae3,0x6040,0xe848,0x61d9,0xe9d1,
+    0xf497,0x7c9f,0xf50e,0x7d06,0xf7a5,0x7fad,0xf63c,0x7e34,
+    0xf2f3,0x7afb,0xf36a,0x7b62,0xf1c1,0x79c9,0xf058,0x7850,
+    0x579d,0xdf95,0x5604,0xde0c,0x54af,0xdca7,0x5536,0xdd3e,
+    0x51f9,0xd9f1,0x5060,0xd868,0x52cb,0xdac3,0x5352,0xdb5a,
+    0xc61c,0x4e14,0xc785,0x4f8d,0xc52e,0x4d26,0xc4b7,0x4cbf,
+    0xc078,0x4870,0xc1e1,0x49e9,0xc34a,0x4b42,0xc2d3,0x4adb,
+    0xca2c,0x4224,0xcbb5,0x43bd,0xc91e,0x4116,0xc887,0x408f,
+    0xcc48,0x4440,0xcdd1,0x45d9,0xcf7a,0x4772,0xcee3,0x46eb,
+    0x5bad,0xd3a5,0x5a34,0xd23c,0x589f,0xd097,0x5906,0xd10e,
+    0x5dc9,0xd5c1,0x5c50,0xd458,0x5efb,0xd6f3,0x5f62,0xd76a,
+    0xf8a7,0x70af,0xf93e,0x7136,0xfb95,0x739d,0xfa0c,0x7204,
+    0xfec3,0x76cb,0xff5a,0x7752,0xfdf1,0x75f9,0xfc68,0x7460,
+    0x6926,0xe12e,0x68bf,0xe0b7,0x6a14,0xe21c,0x6b8d,0xe385,
+    0x6f42,0xe74a,0x6edb,0xe6d3,0x6c70,0xe478,0x6de9,0xe5e1,
+    0xaf3a,0x2732,0xaea3,0x26ab,0xac08,0x2400,0xad91,0x2599,
+    0xa95e,0x2156,0xa8c7,0x20cf,0xaa6c,0x2264,0xabf5,0x23fd,
+    0x3ebb,0xb6b3,0x3f22,0xb72a,0x3d89,0xb581,0x3c10,0xb418,
+    0x38df,0xb0d7,0x3946,0xb14e,0x3bed,0xb3e5,0x3a74,0xb27c,
+    0x9db1,0x15b9,0x9c28,0x1420,0x9e83,0x168b,0x9f1a,0x1712,
+    0x9bd5,0x13dd,0x9a4c,0x1244,0x98e7,0x10ef,0x997e,0x1176,
+    0x0c30,0x8438,0x0da9,0x85a1,0x0f02,0x870a,0x0e9b,0x8693,
+    0x0a54,0x825c,0x0bcd,0x83c5,0x0966,0x816e,0x08ff,0x80f7
+  },
+  {
+    0x0000,0x0040,0x8889,0x88c9,0x009b,0x00db,0x8812,0x8852,
+    0x0136,0x0176,0x89bf,0x89ff,0x01ad,0x01ed,0x8924,0x8964,
+    0x0400,0x0440,0x8c89,0x8cc9,0x049b,0x04db,0x8c12,0x8c52,
+    0x0536,0x0576,0x8dbf,0x8dff,0x05ad,0x05ed,0x8d24,0x8d64,
+    0x9991,0x99d1,0x1118,0x1158,0x990a,0x994a,0x1183,0x11c3,
+    0x98a7,0x98e7,0x102e,0x106e,0x983c,0x987c,0x10b5,0x10f5,
+    0x9d91,0x9dd1,0x1518,0x1558,0x9d0a,0x9d4a,0x1583,0x15c3,
+    0x9ca7,0x9ce7,0x142e,0x146e,0x9c3c,0x9c7c,0x14b5,0x14f5,
+    0x22ab,0x22eb,0xaa22,0xaa62,0x2230,0x2270,0xaab9,0xaaf9,
+    0x239d,0x23dd,0xab14,0xab54,0x2306,0x2346,0xab8f,0xabcf,
+    0x26ab,0x26eb,0xae22,0xae62,0x2630,0x2670,0xaeb9,0xaef9,
+    0x279d,0x27dd,0xaf14,0xaf54,0x2706,0x2746,0xaf8f,0xafcf,
+    0xbb3a,0xbb7a,0x33b3,0x33f3,0xbba1,0xbbe1,0x3328,0x3368,
+    0xba0c,0xba4c,0x3285,0x32c5,0xba97,0xbad7,0x321e,0x325e,
+    0xbf3a,0xbf7a,0x37b3,0x37f3,0xbfa1,0xbfe1,0x3728,0x3768,
+    0xbe0c,0xbe4c,0x3685,0x36c5,0xbe97,0xbed7,0x361e,0x365e,
+    0x4556,0x4516,0xcddf,0xcd9f,0x45cd,0x458d,0xcd44,0xcd04,
+    0x4460,0x4420,0xcce9,0xcca9,0x44fb,0x44bb,0xcc72,0xcc32,
+    0x4156,0x4116,0xc9df,0xc99f,0x41cd,0x418d,0xc944,0xc904,
+    0x4060,0x4020,0xc8e9,0xc8a9,0x40fb,0x40bb,0xc872,0xc832,
+    0xdcc7,0xdc87,0x544e,0x540e,0xdc5c,0xdc1c,0x54d5,0x5495,
+    0xddf1,0xddb1,0x5578,0x5538,0xdd6a,0xdd2a,0x55e3,0x55a3,
+    0xd8c7,0xd887,0x504e,0x500e,0xd85c,0xd81c,0x50d5,0x5095,
+    0xd9f1,0xd9b1,0x5178,0x5138,0xd96a,0xd92a,0x51e3,0x51a3,
+    0x67fd,0x67bd,0xef74,0xef34,0x6766,0x6726,0xefef,0xefaf,
+    0x66cb,0x668b,0xee42,0xee02,0x6650,0x6610,0xeed9,0xee99,
+    0x63fd,0x63bd,0xeb74,0xeb34,0x6366,0x6326,0xebef,0xebaf,
+    0x62cb,0x628b,0xea42,0xea02,0x6250,0x6210,0xead9,0xea99,
+    0xfe6c,0xfe2c,0x76e5,0x76a5,0xfef7,0xfeb7,0x767e,0x763e,
+    0xff5a,0xff1a,0x77d3,0x7793,0xffc1,0xff81,0x7748,0x7708,
+    0xfa6c,0xfa2c,0x72e5,0x72a5,0xfaf7,0xfab7,0x727e,0x723e,
+    0xfb5a,0xfb1a,0x73d3,0x7393,0xfbc1,0xfb81,0x7348,0x7308
+  },
+  {
+    0x0000,0x4000,0x8140,0xc140,0x9b00,0xdb00,0x1a40,0x5a40,
+    0x2789,0x6789,0xa6c9,0xe6c9,0xbc89,0xfc89,0x3dc9,0x7dc9,
+    0x4624,0x0624,0xc764,0x8764,0xdd24,0x9d24,0x5c64,0x1c64,
+    0x61ad,0x21ad,0xe0ed,0xa0ed,0xfaad,0xbaad,0x7bed,0x3bed,
+    0x9848,0xd848,0x1908,0x5908,0x0348,0x4348,0x8208,0xc208,
+    0xbfc1,0xffc1,0x3e81,0x7e81,0x24c1,0x64c1,0xa581,0xe581,
+    0xde6c,0x9e6c,0x5f2c,0x1f2c,0x456c,0x056c,0xc42c,0x842c,
+    0xf9e5,0xb9e5,0x78a5,0x38a5,0x62e5,0x22e5,0xe3a5,0xa3a5,
+    0xa910,0xe910,0x2850,0x6850,0x3210,0x7210,0xb350,0xf350,
+    0x8e99,0xce99,0x0fd9,0x4fd9,0x1599,0x5599,0x94d9,0xd4d9,
+    0xef34,0xaf34,0x6e74,0x2e74,0x7434,0x3434,0xf574,0xb574,
+    0xc8bd,0x88bd,0x49fd,0x09fd,0x53bd,0x13bd,0xd2fd,0x92fd,
+    0x3158,0x7158,0xb018,0xf018,0xaa58,0xea58,0x2b18,0x6b18,
+    0x16d1,0x56d1,0x9791,0xd791,0x8dd1,0xcdd1,0x0c91,0x4c91,
+    0x777c,0x377c,0xf63c,0xb63c,0xec7c,0xac7c,0x6d3c,0x2d3c,
+    0x50f5,0x10f5,0xd1b5,0x91b5,0xcbf5,0x8bf5,0x4ab5,0x0ab5,
+    0x43a9,0x03a9,0xc2e9,0x82e9,0xd8a9,0x98a9,0x59e9,0x19e9,
+    0x6420,0x2420,0xe560,0xa560,0xff20,0xbf20,0x7e60,0x3e60,
+    0x058d,0x458d,0x84cd,0xc4cd,0x9e8d,0xde8d,0x1fcd,0x5fcd,
+    0x2204,0x6204,0xa344,0xe344,0xb904,0xf904,0x3844,0x7844,
+    0xdbe1,0x9be1,0x5aa1,0x1aa1,0x40e1,0x00e1,0xc1a1,0x81a1,
+    0xfc68,0xbc68,0x7d28,0x3d28,0x6768,0x2768,0xe628,0xa628,
+    0x9dc5,0xddc5,0x1c85,0x5c85,0x06c5,0x46c5,0x8785,0xc785,
+    0xba4c,0xfa4c,0x3b0c,0x7b0c,0x214c,0x614c,0xa00c,0xe00c,
+    0xeab9,0xaab9,0x6bf9,0x2bf9,0x71b9,0x31b9,0xf0f9,0xb0f9,
+    0xcd30,0x8d30,0x4c70,0x0c70,0x5630,0x1630,0xd770,0x9770,
+    0xac9d,0xec9d,0x2ddd,0x6ddd,0x379d,0x779d,0xb6dd,0xf6dd,
+    0x8b14,0xcb14,0x0a54,0x4a54,0x1014,0x5014,0x9154,0xd154,
+    0x72f1,0x32f1,0xf3b1,0xb3b1,0xe9f1,0xa9f1,0x68b1,0x28b1,
+    0x5578,0x1578,0xd438,0x9438,0xce78,0x8e78,0x4f38,0x0f38,
+    0x34d5,0x74d5,0xb595,0xf595,0xafd5,0xefd5,0x2e95,0x6e95,
+    0x135c,0x535c,0x921c,0xd21c,0x885c,0xc85c,0x091c,0x491c
+  }
+};
+
+static const uint16_t * const crc16tab[] = {
   crc16tab_1021,
   crc16tab_1189
 };
 
+static const uint16_t (* const crc16slices[])[256] = {
+  crc16tab_1021_slices,
+  crc16tab_1189_slices
+};
+
 uint16_t crc16(uint8_t index, const uint8_t * buf, uint32_t len, uint16_t start)
 {
   uint16_t crc = start;
-  const unsigned short * tab = crc16tab[index];
+  const uint16_t * tab = crc16tab[index];
+  const uint16_t (* slices)[256] = crc16slices[index];
+  while (len >= 4) {
+    uint16_t value = crc ^ ((buf[0] << 8) + buf[1]);
+    crc = slices[2][value >> 8] ^ slices[1][value & 0xFF] ^ slices[0][buf[2]] ^ tab[buf[3]];
+    buf += 4;
+    len -= 4;
+  }
   for (uint32_t i=0; i<len; i++) {
     crc = (crc<<8) ^ tab[((crc>>8) ^ *buf++) & 0x00FF];
   }
@@ -71,11 +367,137 @@ const unsigned char crc8tab[256] = {
   0xAD, 0x78, 0xD2, 0x07, 0x53, 0x86, 0x2C, 0xF9
 };
 
-uint8_t crc8(const uint8_t * ptr, uint32_t len)
+static const unsigned char crc8tab_slices[3][256] = {
+  {
+    0x00, 0x0B, 0x16, 0x1D, 0x2C, 0x27, 0x3A, 0x31,
+    0x58, 0x53, 0x4E, 0x45, 0x74, 0x7F, 0x62, 0x69,
+    0xB0, 0xBB, 0xA6, 0xAD, 0x9C, 0x97, 0x8A, 0x81,
+    0xE8, 0xE3, 0xFE, 0xF5, 0xC4, 0xCF, 0xD2, 0xD9,
+    0xB5, 0xBE, 0xA3, 0xA8, 0x99, 0x92, 0x8F, 0x84,
+    0xED, 0xE6, 0xFB, 0xF0, 0xC1, 0xCA, 0xD7, 0xDC,
+    0x05, 0x0E, 0x13, 0x18, 0x29, 0x22, 0x3F, 0x34,
+    0x5D, 0x56, 0x4B, 0x40, 0x71, 0x7A, 0x67, 0x6C,
+    0xBF, 0xB4, 0xA9, 0xA2, 0x93, 0x98, 0x85, 0x8E,
+    0xE7, 0xEC, 0xF1, 0xFA, 0xCB, 0xC0, 0xDD, 0xD6,
+    0x0F, 0x04, 0x19, 0x12, 0x23, 0x28, 0x35, 0x3E,
+    0x57, 0x5C, 0x41, 0x4A, 0x7B, 0x70, 0x6D, 0x66,
+    0x0A, 0x01, 0x1C, 0x17, 0x26, 0x2D, 0x30, 0x3B,
+    0x52, 0x59, 0x44, 0x4F, 0x7E, 0x75, 0x68, 0x63,
+    0xBA, 0xB1, 0xAC, 0xA7, 0x96, 0x9D, 0x80, 0x8B,
+    0xE2, 0xE9, 0xF4, 0xFF, 0xCE, 0xC5, 0xD8, 0xD3,
+    0xAB, 0xA0, 0xBD, 0xB6, 0x87, 0x8C, 0x91, 0x9A,
+    0xF3, 0xF8, 0xE5, 0xEE, 0xDF, 0xD4, 0xC9, 0xC2,
+    0x1B, 0x10, 0x0D, 0x06, 0x37, 0x3C, 0x21, 0x2A,
+    0x43, 0x48, 0x55, 0x5E, 0x6F, 0x64, 0x79, 0x72,
+    0x1E, 0x15, 0x08, 0x03, 0x32, 0x39, 0x24, 0x2F,
+    0x46, 0x4D, 0x50, 0x5B, 0x6A, 0x61, 0x7C, 0x77,
+    0xAE, 0xA5, 0xB8, 0xB3, 0x82, 0x89, 0x94, 0x9F,
+    0xF6, 0xFD, 0xE0, 0xEB, 0xDA, 0xD1, 0xCC, 0xC7,
+    0x14, 0x1F, 0x02, 0x09, 0x38, 0x33, 0x2E, 0x25,
+    0x4C, 0x47, 0x5A, 0x51, 0x60, 0x6B, 0x76, 0x7D,
+    0xA4, 0xAF, 0xB2, 0xB9, 0x88, 0x83, 0x9E, 0x95,
+    0xFC, 0xF7, 0xEA, 0xE1, 0xD0, 0xDB, 0xC6, 0xCD,
+    0xA1, 0xAA, 0xB7, 0xBC, 0x8D, 0x86, 0x9B, 0x90,
+    0xF9, 0xF2, 0xEF, 0xE4, 0xD5, 0xDE, 0xC3, 0xC8,
+    0x11, 0x1A, 0x07, 0x0C, 0x3D, 0x36, 0x2B, 0x20,
+    0x49, 0x42, 0x5F, 0x54, 0x65, 0x6E, 0x73, 0x78
+  },
+  {
+    0x00, 0x83, 0xD3, 0x50, 0x73, 0xF0, 0xA0, 0x23,
+    0xE6, 0x65, 0x35, 0xB6, 0x95, 0x16, 0x46, 0xC5,
+    0x19, 0x9A, 0xCA, 0x49, 0x6A, 0xE9, 0xB9, 0x3A,
+    0xFF, 0x7C, 0x2C, 0xAF, 0x8C, 0x0F, 0x5F, 0xDC,
+    0x32, 0xB1, 0xE1, 0x62, 0x41, 0xC2, 0x92, 0x11,
+    0xD4, 0x57, 0x07, 0x84, 0xA7, 0x24, 0x74, 0xF7,
+    0x2B, 0xA8, 0xF8, 0x7B, 0x58, 0xDB, 0x8B, 0x08,
+    0xCD, 0x4E, 0x1E, 0x9D, 0xBE, 0x3D, 0x6D, 0xEE,
+    0x64, 0xE7, 0xB7, 0x34, 0x17, 0x94, 0xC4, 0x47,
+    0x82, 0x01, 0x51, 0xD2, 0xF1, 0x72, 0x22, 0xA1,
+    0x7D, 0xFE, 0xAE, 0x2D, 0x0E, 0x8D, 0xDD, 0x5E,
+    0x9B, 0x18, 0x48, 0xCB, 0xE8, 0x6B, 0x3B, 0xB8,
+    0x56, 0xD5, 0x85, 0x06, 0x25, 0xA6, 0xF6, 0x75,
+    0xB0, 0x33, 0x63, 0xE0, 0xC3, 0x40, 0x10, 0x93,
+    0x4F, 0xCC, 0x9C, 0x1F, 0x3C, 0xBF, 0xEF, 0x6C,
+    0xA9, 0x2A, 0x7A, 0xF9, 0xDA, 0x59, 0x09, 0x8A,
+    0xC8, 0x4B, 0x1B, 0x98, 0xBB, 0x38, 0x68, 0xEB,
+    0x2E, 0xAD, 0xFD, 0x7E, 0x5D, 0xDE, 0x8E, 0x0D,
+    0xD1, 0x52, 0x02, 0x81, 0xA2, 0x21, 0x71, 0xF2,
+    0x37, 0xB4, 0xE4, 0x67, 0x44, 0xC7, 0x97, 0x14,
+    0xFA, 0x79, 0x29, 0xAA, 0x89, 0x0A, 0x5A, 0xD9,
+    0x1C, 0x9F, 0xCF, 0x4C, 0x6F, 0xEC, 0xBC, 0x3F,
+    0xE3, 0x60, 0x30, 0xB3, 0x90, 0x13, 0x43, 0xC0,
+    0x05, 0x86, 0xD6, 0x55, 0x76, 0xF5, 0xA5, 0x26,
+    0xAC, 0x2F, 0x7F, 0xFC, 0xDF, 0x5C, 0x0C, 0x8F,
+    0x4A, 0xC9, 0x99, 0x1A, 0x39, 0xBA, 0xEA, 0x69,
+    0xB5, 0x36, 0x66, 0xE5, 0xC6, 0x45, 0x15, 0x96,
+    0x53, 0xD0, 0x80, 0x03, 0x20, 0xA3, 0xF3, 0x70,
+    0x9E, 0x1D, 0x4D, 0xCE, 0xED, 0x6E, 0x3E, 0xBD,
+    0x78, 0xFB, 0xAB, 0x28, 0x0B, 0x88, 0xD8, 0x5B,
+    0x87, 0x04, 0x54, 0xD7, 0xF4, 0x77, 0x27, 0xA4,
+    0x61, 0xE2, 0xB2, 0x31, 0x12, 0x91, 0xC1, 0x42
+  },
+  {
+    0x00, 0x45, 0x8A, 0xCF, 0xC1, 0x84, 0x4B, 0x0E,
+    0x57, 0x12, 0xDD, 0x98, 0x96, 0xD3, 0x1C, 0x59,
+    0xAE, 0xEB, 0x24, 0x61, 0x6F, 0x2A, 0xE5, 0xA0,
+    0xF9, 0xBC, 0x73, 0x36, 0x38, 0x7D, 0xB2, 0xF7,
+    0x89, 0xCC, 0x03, 0x46, 0x48, 0x0D, 0xC2, 0x87,
+    0xDE, 0x9B, 0x54, 0x11, 0x1F, 0x5A, 0x95, 0xD0,
+    0x27, 0x62, 0xAD, 0xE8, 0xE6, 0xA3, 0x6C, 0x29,
+    0x70, 0x35, 0xFA, 0xBF, 0xB1, 0xF4, 0x3B, 0x7E,
+    0xC7, 0x82, 0x4D, 0x08, 0x06, 0x43, 0x8C, 0xC9,
+    0x90, 0xD5, 0x1A, 0x5F, 0x51, 0x14, 0xDB, 0x9E,
+    0x69, 0x2C, 0xE3, 0xA6, 0xA8, 0xED, 0x22, 0x67,
+    0x3E, 0x7B, 0xB4, 0xF1, 0xFF, 0xBA, 0x75, 0x30,
+    0x4E, 0x0B, 0xC4, 0x81, 0x8F, 0xCA, 0x05, 0x40,
+    0x19, 0x5C, 0x93, 0xD6, 0xD8, 0x9D, 0x52, 0x17,
+    0xE0, 0xA5, 0x6A, 0x2F, 0x21, 0x64, 0xAB, 0xEE,
+    0xB7, 0xF2, 0x3D, 0x78, 0x76, 0x33, 0xFC, 0xB9,
+    0x5B, 0x1E, 0xD1, 0x94, 0x9A, 0xDF, 0x10, 0x55,
+    0x0C, 0x49, 0x86, 0xC3, 0xCD, 0x88, 0x47, 0x02,
+    0xF5, 0xB0, 0x7F, 0x3A, 0x34, 0x71, 0xBE, 0xFB,
+    0xA2, 0xE7, 0x28, 0x6D, 0x63, 0x26, 0xE9, 0xAC,
+    0xD2, 0x97, 0x58, 0x1D, 0x13, 0x56, 0x99, 0xDC,
+    0x85, 0xC0, 0x0F, 0x4A, 0x44, 0x01, 0xCE, 0x8B,
+    0x7C, 0x39, 0xF6, 0xB3, 0xBD, 0xF8, 0x37, 0x72,
+    0x2B, 0x6E, 0xA1, 0xE4, 0xEA, 0xAF, 0x60, 0x25,
+    0x9C, 0xD9, 0x16, 0x53, 0x5D, 0x18, 0xD7, 0x92,
+    0xCB, 0x8E, 0x41, 0x04, 0x0A, 0x4F, 0x80, 0xC5,
+    0x32, 0x77, 0xB8, 0xFD, 0xF3, 0xB6, 0x79, 0x3C,
+    0x65, 0x20, 0xEF, 0xAA, 0xA4, 0xE1, 0x2E, 0x6B,
+    0x15, 0x50, 0x9F, 0xDA, 0xD4, 0x91, 0x5E, 0x1B,
+    0x42, 0x07, 0xC8, 0x8D, 0x83, 0xC6, 0x09, 0x4C,
+    0xBB, 0xFE, 0x31, 0x74, 0x7A, 0x3F, 0xF0, 0xB5,
+    0xEC, 0xA9, 0x66, 0x23, 0x2D, 0x68, 0xA7, 0xE2
+  }
+};
+
+uint8_t crc8(const uint8_t * ptr, uint32_t len, uint8_t start)
 {
-  uint8_t crc = 0;
+  uint8_t crc = start;
+  while (len >= 4) {
+    crc = crc8tab_slices[2][crc ^ ptr[0]] ^ crc8tab_slices[1][ptr[1]] ^ crc8tab_slices[0][ptr[2]] ^ crc8tab[ptr[3]];
+    ptr += 4;
+    len -= 4;
+  }
   for (uint32_t i=0; i<len; i++) {
     crc = crc8tab[crc ^ *ptr++];
   }
   return crc;
 }
+
+uint8_t checksum8(const uint8_t * ptr, uint32_t len, uint8_t start)
+{
+  uint8_t sum = start;
+  while (len >= 4) {
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(value));
+    sum += value + (value >> 8) + (value >> 16) + (value >> 24);
+    ptr += 4;
+    len -= 4;
+  }
+  for (uint32_t i=0; i<len; i++) {
+    sum += *ptr++;
+  }
+  return sum;
+}
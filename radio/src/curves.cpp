@@ -53,6 +53,7 @@ void loadCurves()
     curveEnd[i] = tmp;
 
   }
+  invalidateCurveTangents();
   if (showWarning) {
     POPUP_WARNING("Invalid curve data repaired");
     const char * w = "check your curves, logic switches";
@@ -212,6 +213,38 @@ int32_t compute_tangent(CurveInfo * crv, int8_t * points, int i)
     return m;
 }
 
+// Tangents of the smooth curves, computed when the curve is first used after a model change
+int32_t curveTangents[MAX_CURVES][MAX_POINTS_PER_CURVE];
+uint32_t curveTangentsValid = 0;
+uint8_t curveTangentsGeneration = 0;
+
+#if MAX_CURVES > 32
+  #error "curveTangentsValid is too small"
+#endif
+
+void invalidateCurveTangents()
+{
+  curveTangentsGeneration++;
+  curveTangentsValid = 0;
+}
+
+static int32_t * getCurveTangents(CurveInfo * crv, int8_t * points, uint8_t idx)
+{
+  int32_t * tangents = curveTangents[idx];
+  if (curveTangentsValid & (1u << idx))
+    return tangents;
+  uint8_t generation = curveTangentsGeneration;
+  uint8_t count = crv->points+5;
+  for (uint8_t i=0; i<count; i++) {
+    tangents[i] = compute_tangent(crv, points, i);
+  }
+  // the model may have been changed by another task in the meantime
+  if (generation == curveTangentsGeneration) {
+    curveTangentsValid |= (1u << idx);
+  }
+  return tangents;
+}
+
 /* The following is a hermite cubic spline.
    The basis functions can be found here:
    http://en.wikipedia.org/wiki/Cubic_Hermite_spline
@@ -229,7 +262,14 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
   else if (x > RESX)
     x = RESX;
 
-  for (int i=0; i<count-1; i++) {
+  // standard curves have evenly spaced points, the segment is found directly
+  // (x on a segment boundary gives the same result on both sides)
+  int first = 0;
+  if (!custom) {
+    first = min<int>(((x+RESX)*(count-1))/(2*RESX), count-2);
+  }
+
+  for (int i=first; i<count-1; i++) {
     int32_t p0x, p3x;
     if (custom) {
       p0x = (i>0 ? calc100toRESX(points[count+i-1]) : -RESX);
@@ -241,10 +281,11 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
     }
 
     if (x >= p0x && x <= p3x) {
+      int32_t * tangents = getCurveTangents(&crv, points, idx);
       int32_t p0y = calc100toRESX(points[i]);
       int32_t p3y = calc100toRESX(points[i+1]);
-      int32_t m0 = compute_tangent(&crv, points, i);
-      int32_t m3 = compute_tangent(&crv, points, i+1);
+      int32_t m0 = tangents[i];
+      int32_t m3 = tangents[i+1];
       int32_t y;
       int32_t h = p3x - p0x;
       int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
@@ -35,125 +35,312 @@
 DiskCache diskCache;
 
 DiskCacheBlock::DiskCacheBlock():
-  startSector(0),
-  endSector(0) 
+  block(DISK_CACHE_NO_BLOCK),
+  lastAccess(0),
+  dirty(0),
+  readAhead(false)
 {
 }
 
-bool DiskCacheBlock::read(BYTE * buff, DWORD sector, UINT count)
+void DiskCacheBlock::read(BYTE * buff, DWORD sector, UINT count)
 {
-  if (sector >= startSector && (sector+count) <= endSector) {
-    TRACE_DISK_CACHE("\tcache read(%u, %u) from %p", (uint32_t)sector, (uint32_t)count, this);
-    memcpy(buff, data + ((sector - startSector) * BLOCK_SIZE), count * BLOCK_SIZE);
-    return true;
+  TRACE_DISK_CACHE("\tcache read(%u, %u) from %p", (uint32_t)sector, (uint32_t)count, this);
+  memcpy(buff, data + ((sector - block * DISK_CACHE_BLOCK_SECTORS) * BLOCK_SIZE), count * BLOCK_SIZE);
+}
+
+// copies the part of [sector, sector+count) which is inside this block
+void DiskCacheBlock::write(const BYTE * buff, DWORD sector, UINT count, bool writeBack)
+{
+  if (empty()) {
+    return;
+  }
+  DWORD startSector = block * DISK_CACHE_BLOCK_SECTORS;
+  DWORD first = max<DWORD>(sector, startSector);
+  DWORD last = min<DWORD>(sector + count, startSector + DISK_CACHE_BLOCK_SECTORS);
+  if (first >= last) {
+    return;
   }
-  return false;
+  TRACE_DISK_CACHE("\tcache write(%u, %u) to %p", (uint32_t)first, (uint32_t)(last - first), this);
+  memcpy(data + (first - startSector) * BLOCK_SIZE, buff + (first - sector) * BLOCK_SIZE, (last - first) * BLOCK_SIZE);
+  uint16_t mask = ((1 << (last - first)) - 1) << (first - startSector);
+  if (writeBack)
+    dirty |= mask;
+  else
+    dirty &= ~mask;
 }
 
-DRESULT DiskCacheBlock::fill(BYTE drv, BYTE * buff, DWORD sector, UINT count)
+DRESULT DiskCacheBlock::fill(BYTE drv, DWORD block)
 {
-  DRESULT res = __disk_read(drv, data, sector, DISK_CACHE_BLOCK_SECTORS);
+  DRESULT res = __disk_read(drv, data, block * DISK_CACHE_BLOCK_SECTORS, DISK_CACHE_BLOCK_SECTORS);
   if (res != RES_OK) {
+    free();
     return res;
   }
-  startSector = sector;
-  endSector = sector + DISK_CACHE_BLOCK_SECTORS;
-  memcpy(buff, data, count * BLOCK_SIZE);
-  TRACE_DISK_CACHE("\tcache %p FILLED from read(%u, %u)", this, (uint32_t)sector, (uint32_t)count);
+  this->block = block;
+  dirty = 0;
+  readAhead = false;
+  TRACE_DISK_CACHE("\tcache %p FILLED with block %u", this, (uint32_t)block);
   return RES_OK;
 }
 
-void DiskCacheBlock::free(DWORD sector, UINT count) 
+// writes the dirty sectors, a disk write for each run of consecutive ones
+DRESULT DiskCacheBlock::flush(BYTE drv)
 {
-  if (sector < endSector && (sector+count) > startSector) {
-    TRACE_DISK_CACHE("\tINVALIDATING disk cache block %p (%u)", this, startSector);
-    endSector = 0;
+  DWORD startSector = block * DISK_CACHE_BLOCK_SECTORS;
+  while (dirty) {
+    uint8_t first = 0;
+    while (!(dirty & (1 << first))) {
+      first++;
+    }
+    uint8_t last = first;
+    while (last < DISK_CACHE_BLOCK_SECTORS && (dirty & (1 << last))) {
+      last++;
+    }
+    TRACE_DISK_CACHE("\tcache %p FLUSH(%u, %u)", this, (uint32_t)(startSector + first), (uint32_t)(last - first));
+    DRESULT res = __disk_write(drv, data + first * BLOCK_SIZE, startSector + first, last - first);
+    if (res != RES_OK) {
+      return res;
+    }
+    dirty &= ~(((1 << (last - first)) - 1) << first);
   }
+  return RES_OK;
 }
 
 void DiskCacheBlock::free()
 {
-  endSector = 0;
+  block = DISK_CACHE_NO_BLOCK;
+  dirty = 0;
+  readAhead = false;
 }
 
 bool DiskCacheBlock::empty() const
 {
-  return (endSector == 0);
+  return (block == DISK_CACHE_NO_BLOCK);
 }
 
-DiskCache::DiskCache():
-  lastBlock(0)
+DiskCache::DiskCache()
 {
-  stats.noHits = 0;
-  stats.noMisses = 0;
-  stats.noWrites = 0;
   blocks = new DiskCacheBlock[DISK_CACHE_BLOCKS_NUM];
+  clear();
 }
 
 void DiskCache::clear()
 {
-  lastBlock = 0;
-  stats.noHits = 0;
-  stats.noMisses = 0;
-  stats.noWrites = 0;
+  memclear(&stats, sizeof(stats));
+  accessCounter = 0;
+  sequentialBlock = DISK_CACHE_NO_BLOCK;
+  readAhead = 0;
   for (int n=0; n<DISK_CACHE_BLOCKS_NUM; ++n) {
     blocks[n].free();
   }
 }
 
-DRESULT DiskCache::read(BYTE drv, BYTE * buff, DWORD sector, UINT count)
+// a block may only be in one set: blocks[set * DISK_CACHE_WAYS] .. blocks[set * DISK_CACHE_WAYS + DISK_CACHE_WAYS - 1]
+// consecutive blocks go to different sets, so that a sequential read doesn't evict the whole cache
+DiskCacheBlock * DiskCache::find(DWORD block)
 {
-  // TODO: check if not caching first sectors would improve anything
-  // if (sector < 1000) {
-  //   ++stats.noMisses;
-  //   return __disk_read(drv, buff, sector, count);  
-  // }
+  DiskCacheBlock * set = &blocks[(block % DISK_CACHE_SETS_NUM) * DISK_CACHE_WAYS];
+  for (int n=0; n<DISK_CACHE_WAYS; ++n) {
+    if (set[n].block == block) {
+      return &set[n];
+    }
+  }
+  return NULL;
+}
 
-  // if read is bigger than cache block, then read it directly without using cache
-  if (count > DISK_CACHE_BLOCK_SECTORS) {
-    TRACE_DISK_CACHE("\t\t big read(%u, %u)",  (uint32_t)sector, (uint32_t)count);
-    return __disk_read(drv, buff, sector, count);
+// returns an empty block of the set of this block, evicting the least recently used one if needed
+DRESULT DiskCache::allocate(BYTE drv, DWORD block, DiskCacheBlock * & result)
+{
+  DiskCacheBlock * set = &blocks[(block % DISK_CACHE_SETS_NUM) * DISK_CACHE_WAYS];
+  DiskCacheBlock * victim = &set[0];
+  for (int n=0; n<DISK_CACHE_WAYS; ++n) {
+    if (set[n].empty()) {
+      victim = &set[n];
+      break;
+    }
+    if (set[n].lastAccess < victim->lastAccess) {
+      victim = &set[n];
+    }
   }
-  
-  // if block + cache block size is beyond the end of the disk, then read it directly without using cache
-  if (sector+DISK_CACHE_BLOCK_SECTORS >= sdGetNoSectors()) {
-    TRACE_DISK_CACHE("\t\t cache would be beyond end of disk %u (%u)", (uint32_t)sector, sdGetNoSectors());
-    return __disk_read(drv, buff, sector, count);
+
+  if (!victim->empty()) {
+    TRACE_DISK_CACHE("\t\t evicting block %u", (uint32_t)victim->block);
+    ++stats.noEvictions;
+    if (victim->dirty) {
+      ++stats.noFlushes;
+      DRESULT res = victim->flush(drv);
+      if (res != RES_OK) {
+        return res;
+      }
+    }
+    victim->free();
   }
 
+  result = victim;
+  return RES_OK;
+}
+
+void DiskCache::access(DiskCacheBlock * block)
+{
+  block->lastAccess = ++accessCounter;
+}
+
+// flushes the dirty blocks which overlap [sector, sector+count)
+DRESULT DiskCache::flush(BYTE drv, DWORD sector, UINT count)
+{
   for (int n=0; n<DISK_CACHE_BLOCKS_NUM; ++n) {
-    if (blocks[n].read(buff, sector, count)) {
-      ++stats.noHits;
-      return RES_OK;
+    DiskCacheBlock & block = blocks[n];
+    DWORD startSector = block.block * DISK_CACHE_BLOCK_SECTORS;
+    if (block.dirty && sector < startSector + DISK_CACHE_BLOCK_SECTORS && sector + count > startSector) {
+      ++stats.noFlushes;
+      DRESULT res = block.flush(drv);
+      if (res != RES_OK) {
+        return res;
+      }
     }
   }
+  return RES_OK;
+}
 
-  ++stats.noMisses;
-
-  // find free block
+DRESULT DiskCache::flush(BYTE drv)
+{
   for (int n=0; n<DISK_CACHE_BLOCKS_NUM; ++n) {
-    if (blocks[n].empty()) {
-      TRACE_DISK_CACHE("\t\t using free block");
-      return blocks[n].fill(drv, buff, sector, count);
+    if (blocks[n].dirty) {
+      ++stats.noFlushes;
+      DRESULT res = blocks[n].flush(drv);
+      if (res != RES_OK) {
+        return res;
+      }
     }
   }
+  return RES_OK;
+}
 
-  // use next block (round robin)
-  // TODO: use better strategy to select which used block gets used here
-  if (++lastBlock >= DISK_CACHE_BLOCKS_NUM) {
-    lastBlock = 0;
+DRESULT DiskCache::read(BYTE drv, BYTE * buff, DWORD sector, UINT count)
+{
+  // if read is bigger than cache block, then read it directly without using cache
+  // if the cache blocks would be beyond the end of the disk, then read it directly without using cache
+  DWORD lastBlock = (sector + count - 1) / DISK_CACHE_BLOCK_SECTORS;
+  if (count > DISK_CACHE_BLOCK_SECTORS || (lastBlock + 1) * DISK_CACHE_BLOCK_SECTORS > sdGetNoSectors()) {
+    TRACE_DISK_CACHE("\t\t direct read(%u, %u)",  (uint32_t)sector, (uint32_t)count);
+    DRESULT res = flush(drv, sector, count);
+    if (res != RES_OK) {
+      return res;
+    }
+    return __disk_read(drv, buff, sector, count);
   }
-  
-  return blocks[lastBlock].fill(drv, buff, sector, count);
+
+  while (count > 0) {
+    DWORD blockNumber = sector / DISK_CACHE_BLOCK_SECTORS;
+    UINT n = min<UINT>(count, DISK_CACHE_BLOCK_SECTORS - sector % DISK_CACHE_BLOCK_SECTORS);
+    DiskCacheBlock * block = find(blockNumber);
+
+    if (block) {
+      ++stats.noHits;
+      if (block->readAhead) {
+        block->readAhead = false;
+        ++stats.noReadAheadHits;
+      }
+      access(block);
+    }
+    else {
+      ++stats.noMisses;
+      DRESULT res = allocate(drv, blockNumber, block);
+      if (res == RES_OK) {
+        res = block->fill(drv, blockNumber);
+      }
+      if (res != RES_OK) {
+        return res;
+      }
+      access(block);
+
+      // adaptive read-ahead: doubled each time the same stream misses again, stopped by any other miss
+      if (blockNumber == sequentialBlock)
+        readAhead = limit<uint8_t>(1, readAhead * 2, DISK_CACHE_MAX_READ_AHEAD);
+      else
+        readAhead = 0;
+      sequentialBlock = blockNumber + 1;
+      for (uint8_t i=0; i<readAhead; i++) {
+        DWORD next = blockNumber + 1 + i;
+        if ((next + 1) * DISK_CACHE_BLOCK_SECTORS > sdGetNoSectors()) {
+          break;
+        }
+        if (!find(next)) {
+          DiskCacheBlock * nextBlock;
+          if (allocate(drv, next, nextBlock) != RES_OK || nextBlock->fill(drv, next) != RES_OK) {
+            break;
+          }
+          nextBlock->readAhead = true;
+          access(nextBlock);
+          ++stats.noReadAheads;
+        }
+        sequentialBlock = next + 1;
+      }
+    }
+
+    block->read(buff, sector, n);
+    buff += n * BLOCK_SIZE;
+    sector += n;
+    count -= n;
+  }
+
+  return RES_OK;
 }
 
 DRESULT DiskCache::write(BYTE drv, const BYTE* buff, DWORD sector, UINT count)
 {
   ++stats.noWrites;
-  for(int n=0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    blocks[n].free(sector, count);
+
+#if defined(DISK_CACHE_WRITE_BACK)
+  // small writes (FAT, directory entries, ...) stay in the cache until it is flushed
+  // by f_sync() / f_close() (CTRL_SYNC), at unmount or when the block gets evicted
+  DWORD lastBlock = (sector + count - 1) / DISK_CACHE_BLOCK_SECTORS;
+  if (count <= DISK_CACHE_BLOCK_SECTORS && (lastBlock + 1) * DISK_CACHE_BLOCK_SECTORS <= sdGetNoSectors()) {
+    ++stats.noWriteBacks;
+    while (count > 0) {
+      DWORD blockNumber = sector / DISK_CACHE_BLOCK_SECTORS;
+      UINT n = min<UINT>(count, DISK_CACHE_BLOCK_SECTORS - sector % DISK_CACHE_BLOCK_SECTORS);
+      DiskCacheBlock * block = find(blockNumber);
+      if (!block) {
+        DRESULT res = allocate(drv, blockNumber, block);
+        if (res == RES_OK) {
+          if (n < DISK_CACHE_BLOCK_SECTORS)
+            res = block->fill(drv, blockNumber);
+          else
+            block->block = blockNumber;
+        }
+        if (res != RES_OK) {
+          return res;
+        }
+      }
+      access(block);
+      block->write(buff, sector, n, true);
+      buff += n * BLOCK_SIZE;
+      sector += n;
+      count -= n;
+    }
+    return RES_OK;
   }
-  return __disk_write(drv, buff, sector, count);  
+#endif
+
+  DRESULT res = __disk_write(drv, buff, sector, count);
+
+  // the cached copies of these sectors are updated (or dropped if the write failed)
+  for (int n=0; n<DISK_CACHE_BLOCKS_NUM; ++n) {
+    DiskCacheBlock & block = blocks[n];
+    DWORD startSector = block.block * DISK_CACHE_BLOCK_SECTORS;
+    if (!block.empty() && sector < startSector + DISK_CACHE_BLOCK_SECTORS && sector + count > startSector) {
+      if (res == RES_OK) {
+        block.write(buff, sector, count, false);
+      }
+      else {
+        TRACE_DISK_CACHE("\tINVALIDATING disk cache block %p (%u)", &block, (uint32_t)block.block);
+        block.free();
+      }
+    }
+  }
+
+  return res;
 }
 
 const DiskCacheStats & DiskCache::getStats() const 
@@ -26,24 +26,35 @@
 
 // tunable parameters
 #define DISK_CACHE_BLOCKS_NUM      32   // no cache blocks
-#define DISK_CACHE_BLOCK_SECTORS   16   // no sectors
+#define DISK_CACHE_BLOCK_SECTORS   16   // no sectors (max 16, see dirty)
+#define DISK_CACHE_WAYS            4    // no blocks per set
+#define DISK_CACHE_MAX_READ_AHEAD  4    // max no blocks read ahead when reading sequentially
 
 #define DISK_CACHE_BLOCK_SIZE   (DISK_CACHE_BLOCK_SECTORS * BLOCK_SIZE)
+#define DISK_CACHE_SETS_NUM     (DISK_CACHE_BLOCKS_NUM / DISK_CACHE_WAYS)
+#define DISK_CACHE_NO_BLOCK     0xFFFFFFFF
 
+// A cache block always holds DISK_CACHE_BLOCK_SECTORS sectors starting
+// on a multiple of DISK_CACHE_BLOCK_SECTORS (block number * DISK_CACHE_BLOCK_SECTORS)
 class DiskCacheBlock
 {
+  friend class DiskCache;
+
 public:
   DiskCacheBlock();
-  bool read(BYTE* buff, DWORD sector, UINT count);
-  DRESULT fill(BYTE drv, BYTE* buff, DWORD sector, UINT count);
-  void free(DWORD sector, UINT count);
+  void read(BYTE* buff, DWORD sector, UINT count);
+  void write(const BYTE* buff, DWORD sector, UINT count, bool dirty);
+  DRESULT fill(BYTE drv, DWORD block);
+  DRESULT flush(BYTE drv);
   void free();
   bool empty() const;
 
 private:
   uint8_t data[DISK_CACHE_BLOCK_SIZE];
-  DWORD startSector;
-  DWORD endSector;
+  DWORD block;
+  uint32_t lastAccess;  // for the LRU replacement
+  uint16_t dirty;       // sectors not yet written to the disk (write-back)
+  bool readAhead;       // filled by the read-ahead and not yet accessed
 };
 
 struct DiskCacheStats
@@ -51,6 +62,11 @@ struct DiskCacheStats
   uint32_t noHits;
   uint32_t noMisses;
   uint32_t noWrites;
+  uint32_t noEvictions;
+  uint32_t noReadAheads;      // blocks filled by the read-ahead
+  uint32_t noReadAheadHits;   // read-ahead blocks which have been used
+  uint32_t noWriteBacks;      // writes held in the cache (write-back)
+  uint32_t noFlushes;         // dirty blocks written to the disk
 };
 
 class DiskCache
@@ -59,14 +75,21 @@ class DiskCache
     DiskCache();
     DRESULT read(BYTE drv, BYTE* buff, DWORD sector, UINT count);
     DRESULT write(BYTE drv, const BYTE* buff, DWORD sector, UINT count);
+    DRESULT flush(BYTE drv);
     const DiskCacheStats & getStats() const;
     int getHitRate() const;
     void clear();
 
   private:
     DiskCacheStats stats;
-    uint32_t lastBlock;
+    uint32_t accessCounter;
+    DWORD sequentialBlock;  // the block which would continue the current sequential read
+    uint8_t readAhead;
     DiskCacheBlock * blocks;
+    DiskCacheBlock * find(DWORD block);
+    DRESULT allocate(BYTE drv, DWORD block, DiskCacheBlock * & result);
+    DRESULT flush(BYTE drv, DWORD sector, UINT count);
+    void access(DiskCacheBlock * block);
 };
 
 extern DiskCache diskCache;
@@ -68,6 +68,25 @@ class DMAFifo
       }
     }
 
+    // Contiguous bytes already written by the DMA, up to the DMA position or the end of the buffer.
+    // They stay in the fifo until skip(count) is called
+    uint32_t getContiguousData(const uint8_t * & data)
+    {
+#if defined(SIMU)
+      return 0;
+#else
+      uint32_t w = (N - stream->NDTR) & (N-1);
+      uint32_t r = ridx;
+      data = &fifo[r];
+      return (w >= r ? w : N) - r;
+#endif
+    }
+
+    void skip(uint32_t count)
+    {
+      ridx = (ridx + count) & (N-1);
+    }
+
     uint8_t * buffer()
     {
       return fifo;
@@ -52,6 +52,11 @@ class Fifo
       ridx = nextIndex(ridx);
     }
 
+    void skip(uint32_t count)
+    {
+      ridx = (ridx + count) & (N-1);
+    }
+
     bool pop(T & element)
     {
       if (isEmpty()) {
@@ -101,6 +106,16 @@ class Fifo
       }
     }
 
+    // Contiguous elements ready to be read, up to the write index or the end of the buffer.
+    // They stay in the fifo until skip(count) is called
+    uint32_t getContiguousData(const T * & data) const
+    {
+      uint32_t w = widx;
+      uint32_t r = ridx;
+      data = &fifo[r];
+      return (w >= r ? w : N) - r;
+    }
+
   protected:
     T fifo[N];
     volatile uint32_t widx;
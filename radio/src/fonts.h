@@ -36,6 +36,31 @@ extern BitmapBuffer * fontCache[2];
 void loadFontCache();
 #endif
 
+#if !defined(BOOT)
+// Run-length encoded fonts: only the non transparent pixels of each glyph
+// row are kept, grouped by runs of the same opacity
+#define FONT_RUNS_CACHE_SIZE           (128*1024)
+// one entry per different font of fontsTable, they are never evicted
+#define FONT_RUNS_CACHE_ENTRIES        7
+
+struct FontRun {
+  uint8_t row;
+  uint8_t col;
+  uint8_t length;
+  uint8_t opacity;
+};
+
+struct FontRuns {
+  uint16_t count;                      // number of glyphs
+  uint32_t size;                       // allocated size
+  const uint32_t * glyphs;             // index of the first run of each glyph (count+1 entries)
+  const FontRun * runs;
+};
+
+// the runs are built on first use and kept, NULL when the font can't be encoded or doesn't fit in FONT_RUNS_CACHE_SIZE
+const FontRuns * getFontRuns(uint32_t fontindex);
+#endif
+
 #else
 
 extern const pm_uchar font_5x7[];
@@ -92,8 +92,8 @@ void deleteExpoMix(uint8_t expo, uint8_t idx)
     memmove(mix, mix+1, (MAX_MIXERS-(idx+1))*sizeof(MixData));
     memclear(&g_model.mixData[MAX_MIXERS-1], sizeof(MixData));
   }
-  resumeMixerCalculations();
   storageDirty(EE_MODEL);
+  resumeMixerCalculations();
 }
 
 // TODO avoid this global s_currCh on ARM boards ...
@@ -117,8 +117,8 @@ void insertExpoMix(uint8_t expo, uint8_t idx)
     mix->srcRaw = (s_currCh > 4 ? MIXSRC_Rud - 1 + s_currCh : MIXSRC_Rud - 1 + channel_order(s_currCh));
     mix->weight = 100;
   }
-  resumeMixerCalculations();
   storageDirty(EE_MODEL);
+  resumeMixerCalculations();
 }
 
 void copyExpoMix(uint8_t expo, uint8_t idx)
@@ -132,8 +132,8 @@ void copyExpoMix(uint8_t expo, uint8_t idx)
     MixData *mix = mixAddress(idx);
     memmove(mix+1, mix, (MAX_MIXERS-(idx+1))*sizeof(MixData));
   }
-  resumeMixerCalculations();
   storageDirty(EE_MODEL);
+  resumeMixerCalculations();
 }
 
 bool swapExpoMix(uint8_t expo, uint8_t &idx, uint8_t up)
@@ -210,6 +210,7 @@ bool swapExpoMix(uint8_t expo, uint8_t &idx, uint8_t up)
 
   pauseMixerCalculations();
   memswap(x, y, size);
+  MIX_PLAN_INVALIDATE();
   resumeMixerCalculations();
 
   idx = tgt_idx;
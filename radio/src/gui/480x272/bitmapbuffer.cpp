@@ -43,6 +43,8 @@ POSSIBILITY OF SUCH DAMAGE.
  
 #include "opentx.h"
 
+uint16_t BitmapBuffer::scaledColumns[SCALED_BITMAP_MAX_WIDTH];
+
 void BitmapBuffer::drawAlphaPixel(display_t * p, uint8_t opacity, uint16_t color)
 {
   if (opacity == OPACITY_MAX) {
@@ -535,6 +537,52 @@ uint8_t BitmapBuffer::drawCharWithCache(coord_t x, coord_t y, const BitmapBuffer
     drawBitmap(x, y, font, offset, 0, width);
   return width;
 }
+
+uint8_t BitmapBuffer::drawCharWithRuns(coord_t x, coord_t y, const FontRuns * font, const uint16_t * spec, int index, LcdFlags flags)
+{
+  coord_t width = spec[index+1] - spec[index];
+  if (width <= 0)
+    return width;
+
+  APPLY_OFFSET();
+
+  display_t color = lcdColorTable[COLOR_IDX(flags)];
+  const FontRun * run = &font->runs[font->glyphs[index]];
+  const FontRun * end = &font->runs[font->glyphs[index+1]];
+
+  for (; run < end; run++) {
+    coord_t ypixel = y + run->row;
+    if (ypixel < ymin || ypixel >= ymax)
+      continue;
+    coord_t xpixel = x + run->col;
+    coord_t length = run->length;
+    if (xpixel < xmin) {
+      length -= xmin - xpixel;
+      xpixel = xmin;
+    }
+    if (xpixel + length > xmax) {
+      length = xmax - xpixel;
+    }
+    if (length <= 0)
+      continue;
+    display_t * p = getPixelPtr(xpixel, ypixel);
+    if (run->opacity == OPACITY_MAX) {
+      while (length--) {
+        drawPixel(p, color);
+        MOVE_TO_NEXT_RIGHT_PIXEL(p);
+      }
+    }
+    else {
+      while (length--) {
+        drawAlphaPixel(p, run->opacity, color);
+        MOVE_TO_NEXT_RIGHT_PIXEL(p);
+      }
+    }
+  }
+
+  return width;
+}
+
 void BitmapBuffer::drawSizedText(coord_t x, coord_t y, const char * s, uint8_t len, LcdFlags flags)
 {
   MOVE_OFFSET();
@@ -543,6 +591,9 @@ void BitmapBuffer::drawSizedText(coord_t x, coord_t y, const char * s, uint8_t l
     const pm_uchar * font = fontsTable[fontindex];
     const uint16_t * fontspecs = fontspecsTable[fontindex];
     BitmapBuffer * fontcache = NULL;
+#if !defined(BOOT)
+    const FontRuns * fontruns = (flags & VERTICAL) ? NULL : getFontRuns(fontindex);
+#endif
 
 #define INCREMENT_POS(delta) \
   do { if (flags & VERTICAL) y -= delta; else x += delta; } while(0)
@@ -623,10 +674,15 @@ void BitmapBuffer::drawSizedText(coord_t x, coord_t y, const char * s, uint8_t l
 #if 0
       width = drawChar(x-1, y, font, fontspecs, getMappedChar(c), flags);
 #else
+      uint8_t index = getMappedChar(c);
       if (fontcache)
-        width = drawCharWithCache(x-1, y, fontcache, fontspecs, getMappedChar(c), flags);
+        width = drawCharWithCache(x-1, y, fontcache, fontspecs, index, flags);
+#if !defined(BOOT)
+      else if (fontruns && index < fontruns->count)
+        width = drawCharWithRuns(x-1, y, fontruns, fontspecs, index, flags);
+#endif
       else
-        width = drawCharWithoutCache(x-1, y, font, fontspecs, getMappedChar(c), flags);
+        width = drawCharWithoutCache(x-1, y, font, fontspecs, index, flags);
 #endif
       INCREMENT_POS(width);
     }
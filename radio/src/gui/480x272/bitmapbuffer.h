@@ -59,6 +59,11 @@ struct rect_t {
 
 typedef uint16_t display_t;
 
+struct FontRuns;
+
+// scaled bitmaps are clipped to this width
+#define SCALED_BITMAP_MAX_WIDTH        (LCD_W > LCD_H ? LCD_W : LCD_H)
+
 enum BitmapFormats
 {
   BMP_RGB565,
@@ -207,6 +212,7 @@ class BitmapBuffer: public BitmapBufferBase<uint16_t>
     ~BitmapBuffer()
     {
       if (dataAllocated) {
+        DMAWait();
         free(data);
       }
     }
@@ -234,8 +240,10 @@ class BitmapBuffer: public BitmapBufferBase<uint16_t>
 #endif
     }
 
+    // the pixels may still be written by the DMA2D operations in the queue
     inline const display_t * getPixelPtr(coord_t x, coord_t y) const
     {
+      DMAWait();
 #if defined(PCBX10) && !defined(SIMU)
       x = width - x - 1;
       y = height - y - 1;
@@ -245,6 +253,7 @@ class BitmapBuffer: public BitmapBufferBase<uint16_t>
 
     inline display_t * getPixelPtr(coord_t x, coord_t y)
     {
+      DMAWait();
 #if defined(PCBX10) && !defined(SIMU)
       x = width - x - 1;
       y = height - y - 1;
@@ -316,6 +325,8 @@ class BitmapBuffer: public BitmapBufferBase<uint16_t>
 
     uint8_t drawChar(coord_t x, coord_t y, const uint8_t * font, const uint16_t * spec, int index, LcdFlags flags);
 
+    uint8_t drawCharWithRuns(coord_t x, coord_t y, const FontRuns * font, const uint16_t * spec, int index, LcdFlags flags);
+
     void drawSizedText(coord_t x, coord_t y, const char * s, uint8_t len, LcdFlags flags=0);
 
     void clearOffset(coord_t offsetX, coord_t offsetY)
@@ -400,20 +411,33 @@ class BitmapBuffer: public BitmapBufferBase<uint16_t>
           w = width - x;
         if (y + h > height)
           h = height - y;
+        if (w > SCALED_BITMAP_MAX_WIDTH)
+          w = SCALED_BITMAP_MAX_WIDTH;
+
+        // the source columns are the same for each row
+        for (int j = 0; j < w; j++) {
+          scaledColumns[j] = int(j / scale);
+        }
+
         for (int i = 0; i < h; i++) {
           display_t * p = getPixelPtr(x, y + i);
           const display_t * qstart = bmp->getPixelPtr(srcx, srcy + int(i / scale));
-          for (int j = 0; j < w; j++) {
-            const display_t * q = qstart;
-            MOVE_PIXEL_RIGHT(q, int(j / scale));
-            if (bmp->getFormat() == BMP_ARGB4444) {
+          if (bmp->getFormat() == BMP_ARGB4444) {
+            for (int j = 0; j < w; j++) {
+              const display_t * q = qstart;
+              MOVE_PIXEL_RIGHT(q, scaledColumns[j]);
               ARGB_SPLIT(*q, a, r, g, b);
               drawAlphaPixel(p, a, RGB_JOIN(r<<1, g<<2, b<<1));
+              MOVE_TO_NEXT_RIGHT_PIXEL(p);
             }
-            else {
+          }
+          else {
+            for (int j = 0; j < w; j++) {
+              const display_t * q = qstart;
+              MOVE_PIXEL_RIGHT(q, scaledColumns[j]);
               drawPixel(p, *q);
+              MOVE_TO_NEXT_RIGHT_PIXEL(p);
             }
-            MOVE_TO_NEXT_RIGHT_PIXEL(p);
           }
         }
       }
@@ -438,6 +462,8 @@ class BitmapBuffer: public BitmapBufferBase<uint16_t>
     }
 
   protected:
+    static uint16_t scaledColumns[SCALED_BITMAP_MAX_WIDTH];
+
     static BitmapBuffer * load_bmp(const char * filename);
     static BitmapBuffer * load_stb(const char * filename);
 };
@@ -90,6 +90,12 @@ const uint8_t * const fontsTable[16] = {
   font_stdsize, font_tinsize, font_smlsize, font_midsize, font_dblsize, font_xxlsize, font_stdsize, font_stdsize,
   font_stdsizebold, font_tinsize, font_smlsize, font_midsize, font_dblsize, font_xxlsize, font_stdsize, font_stdsize
 };
+
+// the xxlsize font is not compiled in, its data can't be read
+static const uint32_t fontsSizeTable[16] = {
+  sizeof(font_stdsize), sizeof(font_tinsize), sizeof(font_smlsize), sizeof(font_midsize), sizeof(font_dblsize), sizeof(font_xxlsize), sizeof(font_stdsize), sizeof(font_stdsize),
+  sizeof(font_stdsizebold), sizeof(font_tinsize), sizeof(font_smlsize), sizeof(font_midsize), sizeof(font_dblsize), sizeof(font_xxlsize), sizeof(font_stdsize), sizeof(font_stdsize)
+};
 #else
 const uint16_t * const fontspecsTable[1] = { font_stdsize_specs };
 const uint8_t * const fontsTable[1]      = { font_stdsize };
@@ -118,3 +124,111 @@ void loadFontCache()
   fontCache[0] = createFontCache(fontsTable[0], TEXT_COLOR, TEXT_BGCOLOR);
   fontCache[1] = createFontCache(fontsTable[0], TEXT_INVERTED_COLOR, TITLE_BGCOLOR);
 }
+
+#if !defined(BOOT)
+struct FontRunsCacheEntry {
+  const uint8_t * font;
+  FontRuns * runs;
+};
+
+static FontRunsCacheEntry fontRunsCache[FONT_RUNS_CACHE_ENTRIES];
+static uint32_t fontRunsCacheSize = 0;
+
+static FontRuns * createFontRuns(const uint8_t * font, const uint16_t * spec, uint32_t size, uint32_t budget)
+{
+  if (size < 4)
+    return NULL;
+
+  coord_t width = *((uint16_t *)font);
+  coord_t height = *(((uint16_t *)font)+1);
+  if (4 + width * height > size || height > 255)
+    return NULL;
+
+  const uint8_t * pixels = font + 4;
+
+  uint16_t count = 0;
+  while (spec[count] < width) {
+    if (spec[count+1] - spec[count] > 255)
+      return NULL;
+    count++;
+  }
+
+  // first pass to count the runs
+  uint32_t total = 0;
+  for (uint16_t glyph=0; glyph<count; glyph++) {
+    for (coord_t row=0; row<height; row++) {
+      uint8_t previous = 0;
+      for (coord_t col=spec[glyph]; col<spec[glyph+1]; col++) {
+        uint8_t opacity = pixels[row*width + col];
+        if (opacity && opacity != previous)
+          total++;
+        previous = opacity;
+      }
+    }
+  }
+
+  uint32_t allocated = sizeof(FontRuns) + (count + 1) * sizeof(uint32_t) + total * sizeof(FontRun);
+  if (allocated > budget)
+    return NULL;
+
+  FontRuns * result = (FontRuns *)malloc(allocated);
+  if (!result)
+    return NULL;
+
+  uint32_t * glyphs = (uint32_t *)(result + 1);
+  FontRun * runs = (FontRun *)(glyphs + count + 1);
+  result->count = count;
+  result->size = allocated;
+  result->glyphs = glyphs;
+  result->runs = runs;
+
+  FontRun * run = runs;
+  for (uint16_t glyph=0; glyph<count; glyph++) {
+    glyphs[glyph] = run - runs;
+    for (coord_t row=0; row<height; row++) {
+      uint8_t previous = 0;
+      for (coord_t col=spec[glyph]; col<spec[glyph+1]; col++) {
+        uint8_t opacity = pixels[row*width + col];
+        if (opacity && opacity == previous) {
+          (run-1)->length++;
+        }
+        else if (opacity) {
+          run->row = row;
+          run->col = col - spec[glyph];
+          run->length = 1;
+          run->opacity = opacity;
+          run++;
+        }
+        previous = opacity;
+      }
+    }
+  }
+  glyphs[count] = run - runs;
+
+  return result;
+}
+
+const FontRuns * getFontRuns(uint32_t fontindex)
+{
+  const uint8_t * font = fontsTable[fontindex];
+
+  for (uint8_t i=0; i<FONT_RUNS_CACHE_ENTRIES; i++) {
+    FontRunsCacheEntry & entry = fontRunsCache[i];
+    if (entry.font == font) {
+      return entry.runs;
+    }
+    if (!entry.font) {
+      // a font which can't be encoded (or doesn't fit any more) stays in the cache with no runs
+      FontRuns * runs = createFontRuns(font, fontspecsTable[fontindex], fontsSizeTable[fontindex], FONT_RUNS_CACHE_SIZE - fontRunsCacheSize);
+      entry.font = font;
+      entry.runs = runs;
+      if (runs) {
+        fontRunsCacheSize += runs->size;
+      }
+      return runs;
+    }
+  }
+
+  return NULL;
+}
+#endif
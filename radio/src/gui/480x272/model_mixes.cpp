@@ -343,8 +343,8 @@ void insertMix(uint8_t idx, uint8_t channel)
     }
   }
   mix->weight = 100;
-  resumeMixerCalculations();
   storageDirty(EE_MODEL);
+  resumeMixerCalculations();
 }
 
 uint8_t ModelMixesPage::s_mixCopySrcIdx = 0;
@@ -503,8 +503,8 @@ void deleteMix(uint8_t idx)
   MixData * mix = mixAddress(idx);
   memmove(mix, mix + 1, (MAX_MIXERS - (idx + 1)) * sizeof(MixData));
   memclear(&g_model.mixData[MAX_MIXERS - 1], sizeof(MixData));
-  resumeMixerCalculations();
   storageDirty(EE_MODEL);
+  resumeMixerCalculations();
 }
 
 void insertMix(uint8_t idx)
@@ -535,8 +535,8 @@ void copyMix(uint8_t source, uint8_t dest, int8_t ch)
   }
 
   //memmove(mix + 1, mix, (MAX_MIXERS - (dest + 1)) * sizeof(MixData));
-  resumeMixerCalculations();
   storageDirty(EE_MODEL);
+  resumeMixerCalculations();
 }
 
 bool swapMixes(uint8_t &idx, uint8_t up)
@@ -576,6 +576,7 @@ bool swapMixes(uint8_t &idx, uint8_t up)
 
   pauseMixerCalculations();
   memswap(x, y, sizeof(MixData));
+  MIX_PLAN_INVALIDATE();
   resumeMixerCalculations();
 
   idx = tgt_idx;
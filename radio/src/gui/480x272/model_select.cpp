@@ -404,6 +404,8 @@ ModelselectButton::ModelselectButton(ModelselectPage* page, Window * parent, con
                  char duplicatedFilename[LEN_MODEL_FILENAME + 1];
                  memcpy(duplicatedFilename, modelCell->modelFilename, sizeof(duplicatedFilename));
                  if (findNextFileIndex(duplicatedFilename, LEN_MODEL_FILENAME, MODELS_PATH)) {
+                   // the model file has to be up to date (journal compacted) before being copied
+                   storageCheck(true);
                    sdCopyFile(modelCell->modelFilename, MODELS_PATH, duplicatedFilename, MODELS_PATH);
                    modelslist.addModel(currentCategory, duplicatedFilename);
                    page->updateModels(currentCategory->size() - 1);
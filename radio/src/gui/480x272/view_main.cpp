@@ -41,6 +41,7 @@
 #define TRIM_H_Y                       (LCD_H-37)
 #define TRIM_LEN                       80
 #define POTS_LINE_Y                    (LCD_H-20)
+#define TRIMS_AREA_Y                   (TRIM_V_Y-10)
 
 Layout * customScreens[MAX_CUSTOM_SCREENS] = { 0, 0, 0, 0, 0 };
 Topbar * topbar;
@@ -210,8 +211,105 @@ bool ViewMain::onTouchEnd(coord_t x, coord_t y)
 void ViewMain::checkEvents()
 {
   currentEvent.clear();
-  // temporary for refreshing the trims
-  invalidate();
+
+  // the hidden screens (i.e. Lua widgets) keep running even when nothing is redrawn
+  uint8_t view = currentView();
+  for (uint8_t i=0; i<MAX_CUSTOM_SCREENS; i++) {
+    if (i != view && customScreens[i]) customScreens[i]->background();
+  }
+
+  if (isVisible()) {
+    invalidateChanges();
+  }
+}
+
+uint32_t ViewMain::getTopbarHash()
+{
+  struct gtm t;
+  gettime(&t);
+
+  uint32_t hash = MathUtil::hash(&t.tm_mday, sizeof(t.tm_mday));
+  hash ^= MathUtil::hash(&t.tm_mon, sizeof(t.tm_mon));
+  int32_t time = getValue(MIXSRC_TX_TIME);
+  hash ^= MathUtil::hash(&time, sizeof(time));
+  uint16_t values[] = {
+    (uint16_t)usbPlugged(),
+    (uint16_t)TELEMETRY_RSSI(),
+    (uint16_t)g_eeGeneral.beepMode,
+    (uint16_t)requiredSpeakerVolume,
+    (uint16_t)g_vbat100mV,
+#if defined(PCBNV14)
+    (uint16_t)get_battery_charge_state(),
+#endif
+  };
+  hash ^= MathUtil::hash(values, sizeof(values));
+  return hash;
+}
+
+uint32_t ViewMain::getTrimsHash()
+{
+  int32_t values[NUM_TRIMS + NUM_POTS + NUM_SLIDERS + 2];
+  uint8_t index = 0;
+  for (uint8_t i=0; i<NUM_TRIMS; i++) {
+    values[index++] = getTrimValue(mixerCurrentFlightMode, i);
+  }
+  // about one step per pixel of the sliders
+  for (uint8_t i=0; i<NUM_POTS+NUM_SLIDERS; i++) {
+    values[index++] = calibratedAnalogs[CALIBRATED_POT1 + i] / 16;
+  }
+  values[index++] = trimsDisplayTimer > 0 ? trimsDisplayMask : 0;
+#if defined(PCBHORUS)
+  values[index++] = potsPos[1];
+#else
+  values[index++] = 0;
+#endif
+  return MathUtil::hash(values, sizeof(values));
+}
+
+// Only the parts of the view which changed since the last refresh are invalidated
+void ViewMain::invalidateChanges()
+{
+  Layout * layout = customScreens[currentView()];
+  int8_t slide = (int8_t)slideDirection;
+  uint32_t hash = MathUtil::hash(&layout, sizeof(layout));
+  hash ^= MathUtil::hash(&slide, sizeof(slide));
+  hash ^= MathUtil::hash(&mixerCurrentFlightMode, sizeof(mixerCurrentFlightMode));
+  if (!layout || hash != viewHash) {
+    viewHash = hash;
+    invalidate();
+    return;
+  }
+
+  if (layout->topBarHeight()) {
+    hash = getTopbarHash();
+    if (hash != topbarHash) {
+      topbarHash = hash;
+      invalidate({0, 0, LCD_W, layout->topBarHeight()});
+    }
+    invalidateWidgets(topbar);
+  }
+
+  if (layout->trimHeight() || layout->sliderHeight()) {
+    hash = getTrimsHash();
+    if (hash != trimsHash) {
+      trimsHash = hash;
+      invalidate({0, TRIMS_AREA_Y, LCD_W, LCD_H - TRIMS_AREA_Y});
+    }
+  }
+
+  invalidateWidgets(layout);
+}
+
+void ViewMain::invalidateWidgets(WidgetsContainerInterface * container)
+{
+  unsigned int count = container->getZonesCount();
+  for (unsigned int i=0; i<count; i++) {
+    Widget * widget = container->getWidget(i);
+    if (widget && widget->isDirty()) {
+      Zone zone = container->getZone(i);
+      invalidate({zone.x, zone.y, zone.w, zone.h});
+    }
+  }
 }
 uint8_t ViewMain::currentView() {
   if (!customScreens[g_model.view]) {
@@ -250,6 +348,8 @@ void ViewMain::onEvent(event_ext_t event)
 {
   if(!event.evt) return;
   currentEvent.set(&event);
+  // the widgets get the events when they are refreshed, the view is redrawn in this same cycle
+  invalidate();
 }
 
 void ViewMain::paint(BitmapBuffer * dc)
@@ -258,9 +358,6 @@ void ViewMain::paint(BitmapBuffer * dc)
   Layout* layout = customScreens[view];
   theme->drawBackground();
 
-  for (uint8_t i=0; i<MAX_CUSTOM_SCREENS; i++) {
-    if (i != view && customScreens[i]) customScreens[i]->background();
-  }
   if(layout) {
     int32_t y = 0;
     if (layout->topBarHeight()) drawTopBar();
@@ -22,6 +22,8 @@
 #define _VIEW_MAIN_H_
 
 #include "window.h"
+
+class WidgetsContainerInterface;
 enum class SlideDirection {
 	Left = -1,
 	None = 0,
@@ -49,6 +51,10 @@ class ViewMain: public Window {
     void drawTrims(uint8_t flightMode);
     void drawFlightMode(coord_t y);
     void showMenu();
+    void invalidateChanges();
+    void invalidateWidgets(WidgetsContainerInterface * container);
+    uint32_t getTopbarHash();
+    uint32_t getTrimsHash();
 
     const int buttonHeight;
     const int buttonLeftModel;
@@ -56,6 +62,9 @@ class ViewMain: public Window {
     const int buttonLeftTheme;
     SlideDirection slideDirection;
     event_ext_t currentEvent;
+    uint32_t viewHash = 0;
+    uint32_t topbarHash = 0;
+    uint32_t trimsHash = 0;
 };
 
 #endif // _VIEW_MAIN_H_
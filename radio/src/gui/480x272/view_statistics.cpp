@@ -22,8 +22,12 @@
 #include "opentx.h"
 #include "stamp.h"
 #include "libwindows.h"
+#include "mixer_timings.h"
 
 #define MENU_STATS_COLUMN1    (MENUS_MARGIN_LEFT + 120)
+#define TIMINGS_BAR_WIDTH     16
+#define TIMINGS_BAR_HEIGHT    20
+#define TIMINGS_LINE_HEIGHT   (FH + TIMINGS_BAR_HEIGHT + 6)
 
 class StatisticsBody : public Window {
   public:
@@ -294,11 +298,73 @@ class DebugPage : public PageTab {
     static constexpr coord_t footerHeight = 30;
 };
 
+class TimingsBody : public Window {
+  public:
+    TimingsBody(Window * parent, const rect_t &rect) :
+      Window(parent, rect)
+    {
+      coord_t y = MIXER_TIMINGS_COUNT * TIMINGS_LINE_HEIGHT + 10;
+      auto reset = new TextButton(this, {10, y, LCD_W - 20, lineHeight}, "Push to reset");
+      reset->setPressHandler([=]() {
+        mixerTimingsReset();
+        return 0;
+      });
+      setInnerHeight(y + lineHeight + 10);
+    }
+
+    void checkEvents() override
+    {
+      if (get_tmr10ms() - lastRefresh > 50) {
+        invalidate();
+        lastRefresh = get_tmr10ms();
+      }
+    }
+
+    void paint(BitmapBuffer * dc) override
+    {
+      for (uint8_t i = 0; i < MIXER_TIMINGS_COUNT; i++) {
+        TimingHistogram & histogram = mixerTimings[i];
+        coord_t y = i * TIMINGS_LINE_HEIGHT;
+        lcdDrawText(MENUS_MARGIN_LEFT, y, mixerTimingNames[i]);
+        lcdDrawNumber(MENU_STATS_COLUMN1, y, histogram.getAvg(), LEFT, 0, "avg ", "us");
+        lcdDrawNumber(lcdNextPos + 10, y, histogram.getMax(), LEFT, 0, "max ", "us");
+
+        // one bar per bucket, the longest one is TIMINGS_BAR_HEIGHT high
+        uint32_t largest = 0;
+        for (uint8_t j = 0; j < TIMING_HISTOGRAM_BUCKETS; j++) {
+          largest = max(largest, histogram.getBucket(j));
+        }
+        for (uint8_t j = 0; j < TIMING_HISTOGRAM_BUCKETS && largest; j++) {
+          uint32_t count = histogram.getBucket(j);
+          coord_t h = (count * TIMINGS_BAR_HEIGHT + largest - 1) / largest;
+          lcdDrawSolidFilledRect(MENUS_MARGIN_LEFT + j * TIMINGS_BAR_WIDTH, y + FH + TIMINGS_BAR_HEIGHT - h, TIMINGS_BAR_WIDTH - 2, h, TEXT_COLOR);
+        }
+      }
+    }
+
+  protected:
+    tmr10ms_t lastRefresh = 0;
+};
+
+class TimingsPage : public PageTab {
+  public:
+    TimingsPage() :
+      PageTab("Timings", ICON_STATS_DEBUG)
+    {
+    }
+
+    void build(Window * window) override
+    {
+      new TimingsBody(window, {0, 0, LCD_W, window->height()});
+    }
+};
+
 StatisticsMenu::StatisticsMenu() :
   TabsGroup()
 {
   addTab(new StatisticsPage());
   addTab(new DebugPage());
+  addTab(new TimingsPage());
   addTab(new AnalogsPage());
 }
 
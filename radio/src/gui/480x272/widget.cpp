@@ -51,3 +51,10 @@ Widget * loadWidget(const char * name, const Zone & zone, Widget::PersistentData
   }
   return NULL;
 }
+
+bool isZoneInvalidated(const Zone & zone)
+{
+  coord_t xmin, xmax, ymin, ymax;
+  lcd->getClippingRect(xmin, xmax, ymin, ymax);
+  return zone.x < xmax && zone.x + zone.w > xmin && zone.y < ymax && zone.y + zone.h > ymin;
+}
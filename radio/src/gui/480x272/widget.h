@@ -26,6 +26,7 @@
 #include "zone.h"
 #include "debug.h"
 #include "keys.h"
+#include "otx_math.h"
 
 #define MAX_WIDGET_OPTIONS             5
 #if defined(PCBFLYSKY)
@@ -46,7 +47,8 @@ class Widget
       factory(factory),
       zone(zone),
       persistentData(persistentData),
-      selected(false)
+      selected(false),
+      refreshedHash(0)
     {
     }
 
@@ -77,6 +79,24 @@ class Widget
 
     virtual void refresh(event_ext_t event = event_ext_t()) = 0;
 
+    // A hash of what the widget displays, its zone is only redrawn when it
+    // changes. Widgets which can't tell return 0 and are redrawn each time
+    virtual uint32_t getContentHash()
+    {
+      return 0;
+    }
+
+    bool isDirty()
+    {
+      uint32_t hash = getContentHash();
+      return hash == 0 || hash != refreshedHash;
+    }
+
+    void setRefreshedHash(uint32_t hash)
+    {
+      refreshedHash = hash;
+    }
+
     virtual void background()
     {
       selected = false;
@@ -102,6 +122,12 @@ class Widget
     Zone zone;
     PersistentData * persistentData;
     bool selected;
+    uint32_t refreshedHash;
+
+    uint32_t getOptionsHash() const
+    {
+      return MathUtil::hash(persistentData, sizeof(PersistentData));
+    }
 };
 
 void registerWidget(const WidgetFactory * factory);
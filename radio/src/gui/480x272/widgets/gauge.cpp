@@ -31,6 +31,12 @@ class GaugeWidget: public Widget
 
     virtual void refresh(event_ext_t event = event_ext_t());
 
+    virtual uint32_t getContentHash()
+    {
+      int32_t value = getValue(persistentData->options[0].unsignedValue);
+      return getOptionsHash() ^ MathUtil::hash(&value, sizeof(value));
+    }
+
     static const ZoneOption options[];
 };
 
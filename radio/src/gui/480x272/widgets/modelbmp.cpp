@@ -60,11 +60,17 @@ class ModelBitmapWidget: public Widget
       }
     }
 
-    virtual void refresh(event_ext_t event = event_ext_t())
+    virtual uint32_t getContentHash()
     {
       uint32_t new_hash = MathUtil::hash(g_model.header.bitmap, sizeof(g_model.header.bitmap));
       new_hash ^= MathUtil::hash(g_model.header.name, sizeof(g_model.header.name));
       new_hash ^= MathUtil::hash(g_eeGeneral.themeName, sizeof(g_eeGeneral.themeName));
+      return new_hash;
+    }
+
+    virtual void refresh(event_ext_t event = event_ext_t())
+    {
+      uint32_t new_hash = getContentHash();
       if (new_hash != deps_hash) {
         deps_hash = new_hash;
         refreshBuffer();
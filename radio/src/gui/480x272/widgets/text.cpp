@@ -32,6 +32,11 @@ class TextWidget: public Widget
 
     virtual void refresh(event_ext_t event = event_ext_t());
 
+    virtual uint32_t getContentHash()
+    {
+      return getOptionsHash();
+    }
+
     static const ZoneOption options[];
 };
 
@@ -30,6 +30,15 @@ class TimerWidget: public Widget
 
     virtual void refresh(event_ext_t event = event_ext_t());
 
+    virtual uint32_t getContentHash()
+    {
+      uint32_t index = persistentData->options[0].unsignedValue;
+      uint32_t hash = getOptionsHash();
+      hash ^= MathUtil::hash(&g_model.timers[index], sizeof(TimerData));
+      hash ^= MathUtil::hash(&timersStates[index].val, sizeof(timersStates[index].val));
+      return hash;
+    }
+
     static const ZoneOption options[];
 };
 
@@ -30,6 +30,23 @@ class ValueWidget: public Widget
 
     virtual void refresh(event_ext_t event = event_ext_t());
 
+    virtual uint32_t getContentHash()
+    {
+      mixsrc_t field = persistentData->options[0].unsignedValue;
+      uint32_t hash = getOptionsHash();
+      if (field >= MIXSRC_FIRST_TELEM) {
+        // the reception time only matters when the value becomes old or unavailable
+        TelemetryItem telemetryItem = telemetryItems[(field-MIXSRC_FIRST_TELEM)/3];
+        telemetryItem.lastReceived = telemetryItem.isAvailable() ? telemetryItem.isOld() : TELEMETRY_VALUE_UNAVAILABLE;
+        hash ^= MathUtil::hash(&telemetryItem, sizeof(telemetryItem));
+      }
+      else {
+        int32_t value = getValue(field);
+        hash ^= MathUtil::hash(&value, sizeof(value));
+      }
+      return hash;
+    }
+
     static const ZoneOption options[];
 };
 
@@ -49,6 +49,9 @@ class WidgetsContainerInterface
 
 #define WIDGET_NAME_LEN    10
 
+// true when the zone is part of the area being redrawn
+bool isZoneInvalidated(const Zone & zone);
+
 template<int N, int O>
 class WidgetsContainer: public WidgetsContainerInterface
 {
@@ -156,7 +159,13 @@ class WidgetsContainer: public WidgetsContainerInterface
           }
           else localEvent.clear();
         }
+        // outside of the redrawn area the widget keeps its last content
+        if (!localEvent.evt && !isZoneInvalidated(getZone(i))) {
+          continue;
+        }
+        uint32_t hash = widgets[i]->getContentHash();
         widgets[i]->refresh(localEvent);
+        widgets[i]->setRefreshedHash(hash);
       }
       //TBD select with rotary event
     }
@@ -52,8 +52,8 @@ void deleteMix(uint8_t idx)
   MixData * mix = mixAddress(idx);
   memmove(mix, mix+1, (MAX_MIXERS-(idx+1))*sizeof(MixData));
   memclear(&g_model.mixData[MAX_MIXERS-1], sizeof(MixData));
-  resumeMixerCalculations();
   storageDirty(EE_MODEL);
+  resumeMixerCalculations();
 }
 
 void insertMix(uint8_t idx)
@@ -71,8 +71,8 @@ void insertMix(uint8_t idx)
     }
   }
   mix->weight = 100;
-  resumeMixerCalculations();
   storageDirty(EE_MODEL);
+  resumeMixerCalculations();
 }
 
 void copyMix(uint8_t idx)
@@ -80,8 +80,8 @@ void copyMix(uint8_t idx)
   pauseMixerCalculations();
   MixData * mix = mixAddress(idx);
   memmove(mix+1, mix, (MAX_MIXERS-(idx+1))*sizeof(MixData));
-  resumeMixerCalculations();
   storageDirty(EE_MODEL);
+  resumeMixerCalculations();
 }
 
 bool swapMixes(uint8_t & idx, uint8_t up)
@@ -121,6 +121,7 @@ bool swapMixes(uint8_t & idx, uint8_t up)
 
   pauseMixerCalculations();
   memswap(x, y, sizeof(MixData));
+  MIX_PLAN_INVALIDATE();
   resumeMixerCalculations();
 
   idx = tgt_idx;
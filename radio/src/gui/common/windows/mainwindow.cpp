@@ -32,6 +32,10 @@ STRUCT_TOUCH touchState;
 STRUCT_TOUCH lastTouch;
 
 MainWindow mainWindow;
+
+// Above this area, redrawing the whole screen is cheaper than copying the
+// previous layer first
+#define PARTIAL_REFRESH_MAX_AREA       (LCD_W * LCD_H * 2 / 3)
 std::queue<touch_event_type>TouchQueue;
 
 void MainWindow::emptyTrash()
@@ -155,6 +159,9 @@ bool MainWindow::refresh(bool luaActive)
   if(luaActive && topMostWindow != nullptr) topMostWindow->invalidate();
   if (invalidatedRect.w) {
     if(!luaActive) {
+      if (invalidatedRect.w * invalidatedRect.h > PARTIAL_REFRESH_MAX_AREA) {
+        invalidatedRect = {0, 0, LCD_W, LCD_H};
+      }
       if (invalidatedRect.x > 0 || invalidatedRect.y > 0 || invalidatedRect.w < LCD_W || invalidatedRect.h < LCD_H) {
         //TRACE("Refresh rect: left=%d top=%d width=%d height=%d", invalidatedRect.left(), invalidatedRect.top(), invalidatedRect.w, invalidatedRect.h);
         BitmapBuffer * previous = lcd;
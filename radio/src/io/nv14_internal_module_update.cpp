@@ -117,8 +117,8 @@ bool Nv14UpdateDriver::getBootloaderResponse(STRUCT_HALL* rx, uint16_t timeoutMs
 
 void Nv14UpdateDriver::sendModuleCommand(uint8_t type, uint8_t cmd) const {
   afhds2Command(type, cmd);
-  uint8_t* data = intmodulePulsesData.flysky.pulses;
-  uint16_t size = intmodulePulsesData.flysky.ptr - data;
+  uint8_t* data = (uint8_t*)intmodulePulsesData.flysky.getData();
+  uint16_t size = intmodulePulsesData.flysky.getSize();
   intmoduleSendBufferDMA(data, size);
   //(data, size);
 }
@@ -20,12 +20,22 @@
 
 #include "opentx.h"
 #include "ff.h"
+#if defined(LOG_BINARY)
+#include "logs_binary.h"
+#endif
 
 FIL g_oLogFile __DMA;
 const pm_char * g_logError = NULL;
 uint8_t logDelay;
 
-void writeHeader();
+typedef void (* LogsPutsFunction)(const char * s);
+void writeHeader(LogsPutsFunction logsPuts);
+void logsFilePuts(const char * s);
+#if defined(LOG_BINARY)
+void logsBinaryStart();
+extern volatile bool logsCloseRequest;
+void logsBinaryClose();
+#endif
 
 #if defined(PCBTARANIS) || defined(PCBHORUS)  || defined(PCBI8) || defined(PCBNV14)
   #define GET_2POS_STATE(sw) (switchState(SW_ ## sw ## 0) ? -1 : 1)
@@ -97,16 +107,25 @@ const pm_char * logsOpen()
   tmp = strAppendDate(&filename[len]);
 #endif
 
+#if defined(LOG_BINARY)
+  strcpy(tmp, LOGS_BINARY_EXT);
+#else
   strcpy_P(tmp, STR_LOGS_EXT);
+#endif
 
   result = f_open(&g_oLogFile, filename, FA_OPEN_ALWAYS | FA_WRITE | FA_OPEN_APPEND);
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
 
+#if defined(LOG_BINARY)
+  logsBinaryStart();
+#else
   if (f_size(&g_oLogFile) == 0) {
-    writeHeader();
+    writeHeader(logsFilePuts);
+    f_putc('\n', &g_oLogFile);
   }
+#endif
 
   return NULL;
 }
@@ -116,10 +135,27 @@ tmr10ms_t lastLogTime = 0;
 void logsClose()
 {
   if (sdMounted()) {
+#if defined(LOG_BINARY)
+    // the file is only written and closed by the logs task
+    if (g_oLogFile.obj.fs) {
+      logsCloseRequest = true;
+      RTOS_SET_FLAG(logsFlag);
+      for (uint16_t i=0; i<500 && logsCloseRequest; i++) {
+        RTOS_WAIT_MS(10);
+      }
+      if (logsCloseRequest) {
+        // the logs task does not answer (stopped, or blocked on the SD card), the file is closed from here
+        // so that the FAT is still updated before the power goes off
+        logsBinaryClose();
+        logsCloseRequest = false;
+      }
+    }
+#else
     if (f_close(&g_oLogFile) != FR_OK) {
       // close failed, forget file
       g_oLogFile.obj.fs = 0;
     }
+#endif
     lastLogTime = 0;
   }
 }
@@ -132,27 +168,33 @@ getvalue_t getConvertedTelemetryValue(getvalue_t val, uint8_t unit)
 }
 #endif
 
-void writeHeader()
+void logsFilePuts(const char * s)
+{
+  f_puts(s, &g_oLogFile);
+}
+
+// the CSV header line, without the final '\n'
+void writeHeader(LogsPutsFunction logsPuts)
 {
 #if defined(RTCLOCK)
-  f_puts("Date,Time,", &g_oLogFile);
+  logsPuts("Date,Time,");
 #else
-  f_puts("Time,", &g_oLogFile);
+  logsPuts("Time,");
 #endif
 
 #if defined(TELEMETRY_FRSKY)
 #if !defined(CPUARM)
-  f_puts("Buffer,RX,TX,A1,A2,", &g_oLogFile);
+  logsPuts("Buffer,RX,TX,A1,A2,");
 #if defined(FRSKY_HUB)
   if (IS_USR_PROTO_FRSKY_HUB()) {
-    f_puts("GPS Date,GPS Time,Long,Lat,Course,GPS Speed(kts),GPS Alt,Baro Alt(", &g_oLogFile);
-    f_puts(TELEMETRY_BARO_ALT_UNIT, &g_oLogFile);
-    f_puts("),Vertical Speed,Air Speed(kts),Temp1,Temp2,RPM,Fuel," TELEMETRY_CELLS_LABEL "Current,Consumption,Vfas,AccelX,AccelY,AccelZ,", &g_oLogFile);
+    logsPuts("GPS Date,GPS Time,Long,Lat,Course,GPS Speed(kts),GPS Alt,Baro Alt(");
+    logsPuts(TELEMETRY_BARO_ALT_UNIT);
+    logsPuts("),Vertical Speed,Air Speed(kts),Temp1,Temp2,RPM,Fuel," TELEMETRY_CELLS_LABEL "Current,Consumption,Vfas,AccelX,AccelY,AccelZ,");
   }
 #endif
 #if defined(WS_HOW_HIGH)
   if (IS_USR_PROTO_WS_HOW_HIGH()) {
-    f_puts("WSHH Alt,", &g_oLogFile);
+    logsPuts("WSHH Alt,");
   }
 #endif
 #endif
@@ -173,7 +215,7 @@ void writeHeader()
           strcat(label, ")");
         }
         strcat(label, ",");
-        f_puts(label, &g_oLogFile);
+        logsPuts(label);
       }
     }
   }
@@ -183,12 +225,16 @@ void writeHeader()
 #if defined(PCBTARANIS) || defined(PCBHORUS) || defined(PCBI8) || defined(PCBNV14)
   for (uint8_t i=1; i<NUM_STICKS+NUM_POTS+NUM_SLIDERS+1; i++) {
     const char * p = STR_VSRCRAW + i * STR_VSRCRAW[0] + 2;
-    for (uint8_t j=0; j<STR_VSRCRAW[0]-1; ++j) {
+    char name[8];
+    uint8_t len = 0;
+    for (uint8_t j=0; j<STR_VSRCRAW[0]-1 && len<sizeof(name)-2; ++j) {
       if (!*p) break;
-      f_putc(*p, &g_oLogFile);
+      name[len++] = *p;
       ++p;
     }
-    f_putc(',', &g_oLogFile);
+    name[len++] = ',';
+    name[len] = '\0';
+    logsPuts(name);
   }
 #if defined(PCBX7) || defined(PCBI8) || defined(PCBNV14)
   #define STR_SWITCHES_LOG_HEADER  "SA,SB,SC,SD,SF,SH"
@@ -197,12 +243,12 @@ void writeHeader()
 #else
   #define STR_SWITCHES_LOG_HEADER  "SA,SB,SC,SD,SE,SF,SG,SH"
 #endif
-  f_puts(STR_SWITCHES_LOG_HEADER ",LSW,", &g_oLogFile);
+  logsPuts(STR_SWITCHES_LOG_HEADER ",LSW,");
 #else
-  f_puts("Rud,Ele,Thr,Ail,P1,P2,P3,THR,RUD,ELE,3POS,AIL,GEA,TRN,", &g_oLogFile);
+  logsPuts("Rud,Ele,Thr,Ail,P1,P2,P3,THR,RUD,ELE,3POS,AIL,GEA,TRN,");
 #endif
 
-  f_puts("TxBat(V)\n", &g_oLogFile);
+  logsPuts("TxBat(V)");
 }
 
 uint32_t getLogicalSwitchesStates(uint8_t first)
@@ -214,6 +260,294 @@ uint32_t getLogicalSwitchesStates(uint8_t first)
   return result;
 }
 
+#if defined(LOG_BINARY)
+// Binary logs: the rows are encoded in one of two RAM buffers and the logs
+// task writes the full ones, so that the menus task never waits for the SD card
+// and f_write() gets whole sectors (the first buffer is shortened to align the
+// next ones on the file sectors when appending to an existing file)
+#define LOGS_BUFFER_SIZE               2048
+#define LOGS_HEADER_MAXLEN             (MAX_TELEMETRY_SENSORS * (TELEM_LABEL_LEN + 7) + 160)
+#define LOGS_MAX_COLUMNS               (MAX_TELEMETRY_SENSORS + NUM_STICKS + NUM_POTS + NUM_SLIDERS + 16)
+
+struct LogsBuffer {
+  uint8_t data[LOGS_BUFFER_SIZE];
+  uint16_t size;
+  uint16_t capacity;
+  volatile bool full;
+};
+
+LogsBuffer logsBuffers[2] __DMA;
+uint8_t logsCurrentBuffer;
+uint8_t logsWriteBuffer;
+RTOS_FLAG_HANDLE logsFlag;
+volatile FRESULT logsWriteResult = FR_OK;
+volatile bool logsCloseRequest = false;
+uint32_t logsOverruns = 0;
+
+// the logged sensors and their column types, frozen when the file is opened
+uint8_t logsSensors[MAX_TELEMETRY_SENSORS];
+uint8_t logsSensorsTypes[MAX_TELEMETRY_SENSORS];
+uint8_t logsSensorsCount;
+uint16_t logsRowSize;
+
+uint8_t getLogsSwitchesStates(int8_t * states)
+{
+#if defined(PCBXLITE)
+  const int8_t values[] = { GET_3POS_STATE(SA), GET_3POS_STATE(SB), GET_3POS_STATE(SC), GET_3POS_STATE(SD) };
+#elif defined(PCBX7)
+  const int8_t values[] = { GET_3POS_STATE(SA), GET_3POS_STATE(SB), GET_3POS_STATE(SC), GET_3POS_STATE(SD), GET_2POS_STATE(SF), GET_2POS_STATE(SH) };
+#elif defined(PCBTARANIS) || defined(PCBHORUS)
+  const int8_t values[] = { GET_3POS_STATE(SA), GET_3POS_STATE(SB), GET_3POS_STATE(SC), GET_3POS_STATE(SD), GET_3POS_STATE(SE), GET_2POS_STATE(SF), GET_3POS_STATE(SG), GET_2POS_STATE(SH) };
+#elif defined(PCBI8) || defined(PCBNV14)
+  const int8_t values[] = { GET_3POS_STATE(SA), GET_3POS_STATE(SB), GET_3POS_STATE(SC), GET_3POS_STATE(SD), GET_2POS_STATE(SE), GET_2POS_STATE(SF) };
+#else
+  const int8_t values[] = { GET_2POS_STATE(THR), GET_2POS_STATE(RUD), GET_2POS_STATE(ELE), GET_3POS_STATE(ID), GET_2POS_STATE(AIL), GET_2POS_STATE(GEA), GET_2POS_STATE(TRN) };
+#endif
+  memcpy(states, values, sizeof(values));
+  return sizeof(values);
+}
+
+#if defined(PCBTARANIS) || defined(PCBHORUS) || defined(PCBI8) || defined(PCBNV14)
+  #define LOGS_LOGICAL_SWITCHES_COLUMNS  1
+#else
+  #define LOGS_LOGICAL_SWITCHES_COLUMNS  0
+#endif
+
+// returns false (and counts an overrun) when both buffers are waiting for the SD card
+bool logsBinaryReserve(uint16_t size)
+{
+  LogsBuffer & current = logsBuffers[logsCurrentBuffer];
+  LogsBuffer & next = logsBuffers[logsCurrentBuffer ^ 1];
+  if (current.full || (current.capacity - current.size < size && next.full)) {
+    logsOverruns++;
+    return false;
+  }
+  return true;
+}
+
+void logsBinaryAppend(const void * data, uint16_t size)
+{
+  const uint8_t * p = (const uint8_t *)data;
+  while (size > 0) {
+    LogsBuffer & buffer = logsBuffers[logsCurrentBuffer];
+    uint16_t len = min<uint16_t>(size, buffer.capacity - buffer.size);
+    memcpy(&buffer.data[buffer.size], p, len);
+    buffer.size += len;
+    p += len;
+    size -= len;
+    if (buffer.size == buffer.capacity) {
+      buffer.full = true;
+      RTOS_SET_FLAG(logsFlag);
+      logsCurrentBuffer ^= 1;
+      logsBuffers[logsCurrentBuffer].capacity = LOGS_BUFFER_SIZE;
+    }
+  }
+}
+
+char * logsHeaderPtr;
+char * logsHeaderEnd;
+
+void logsBinaryPuts(const char * s)
+{
+  while (*s && logsHeaderPtr < logsHeaderEnd) {
+    *logsHeaderPtr++ = *s++;
+  }
+}
+
+void logsBinaryStart()
+{
+  for (uint8_t i=0; i<2; i++) {
+    logsBuffers[i].size = 0;
+    logsBuffers[i].full = false;
+  }
+  uint32_t offset = f_size(&g_oLogFile) % LOGS_BUFFER_SIZE;
+  logsCurrentBuffer = logsWriteBuffer = 0;
+  logsBuffers[0].capacity = LOGS_BUFFER_SIZE - offset;
+  logsWriteResult = FR_OK;
+
+  uint8_t types[LOGS_MAX_COLUMNS];
+  uint8_t columns = 0;
+#if defined(RTCLOCK)
+  types[columns++] = LOGS_COLUMN_DATE_TIME;
+#else
+  types[columns++] = LOGS_COLUMN_TIME;
+#endif
+
+  logsSensorsCount = 0;
+  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
+    if (isTelemetryFieldAvailable(i)) {
+      TelemetrySensor & sensor = g_model.telemetrySensors[i];
+      if (sensor.logs) {
+        uint8_t type;
+        if (sensor.unit == UNIT_GPS)
+          type = LOGS_COLUMN_GPS;
+        else if (sensor.unit == UNIT_DATETIME)
+          type = LOGS_COLUMN_SENSOR_DATE_TIME;
+        else if (sensor.prec == 2)
+          type = LOGS_COLUMN_VALUE_PREC2;
+        else if (sensor.prec == 1)
+          type = LOGS_COLUMN_VALUE_PREC1;
+        else
+          type = LOGS_COLUMN_VALUE;
+        logsSensors[logsSensorsCount] = i;
+        logsSensorsTypes[logsSensorsCount++] = type;
+        types[columns++] = type;
+      }
+    }
+  }
+
+  for (uint8_t i=0; i<NUM_STICKS+NUM_POTS+NUM_SLIDERS; i++) {
+    types[columns++] = LOGS_COLUMN_ANALOG;
+  }
+  int8_t switches[16];
+  for (uint8_t i=getLogsSwitchesStates(switches); i>0; i--) {
+    types[columns++] = LOGS_COLUMN_SWITCH;
+  }
+  if (LOGS_LOGICAL_SWITCHES_COLUMNS) {
+    types[columns++] = LOGS_COLUMN_LOGICAL_SWITCHES;
+  }
+  types[columns++] = LOGS_COLUMN_VALUE_PREC1; // TxBat(V)
+
+  logsRowSize = 1; // LOGS_BINARY_ROW_MARKER
+  for (uint8_t i=0; i<columns; i++) {
+    logsRowSize += LOGS_COLUMN_SIZES[types[i]];
+  }
+
+  // each open writes a new header, the schema may have changed since the previous one
+  char names[LOGS_HEADER_MAXLEN];
+  logsHeaderPtr = names;
+  logsHeaderEnd = names + sizeof(names);
+  writeHeader(logsBinaryPuts);
+
+  LogsBinaryHeader header;
+  memcpy(header.magic, LOGS_BINARY_MAGIC, sizeof(header.magic));
+  header.version = LOGS_BINARY_VERSION;
+  header.columns = columns;
+  header.rowSize = logsRowSize;
+  header.namesLength = logsHeaderPtr - names;
+  logsBinaryAppend(&header, sizeof(header));
+  logsBinaryAppend(types, columns);
+  logsBinaryAppend(names, header.namesLength);
+}
+
+void logsBinaryWriteRow(tmr10ms_t tmr10ms)
+{
+  if (!logsBinaryReserve(logsRowSize)) {
+    return;
+  }
+
+  uint8_t marker = LOGS_BINARY_ROW_MARKER;
+  logsBinaryAppend(&marker, sizeof(marker));
+
+#if defined(RTCLOCK)
+  uint32_t time = g_rtcTime;
+  logsBinaryAppend(&time, sizeof(time));
+  logsBinaryAppend(&g_ms100, sizeof(g_ms100));
+#else
+  uint32_t time = tmr10ms;
+  logsBinaryAppend(&time, sizeof(time));
+#endif
+
+  for (uint8_t i=0; i<logsSensorsCount; i++) {
+    TelemetryItem & telemetryItem = telemetryItems[logsSensors[i]];
+    switch (logsSensorsTypes[i]) {
+      case LOGS_COLUMN_GPS:
+      {
+        int32_t gps[2] = { telemetryItem.gps.latitude, telemetryItem.gps.longitude };
+        logsBinaryAppend(gps, sizeof(gps));
+        break;
+      }
+      case LOGS_COLUMN_SENSOR_DATE_TIME:
+      {
+        uint16_t year = telemetryItem.datetime.year;
+        uint8_t datetime[5] = { telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec };
+        logsBinaryAppend(&year, sizeof(year));
+        logsBinaryAppend(datetime, sizeof(datetime));
+        break;
+      }
+      default:
+      {
+        int32_t value = telemetryItem.value;
+        logsBinaryAppend(&value, sizeof(value));
+        break;
+      }
+    }
+  }
+
+  for (uint8_t i=0; i<NUM_STICKS+NUM_POTS+NUM_SLIDERS; i++) {
+    int16_t value = calibratedAnalogs[i];
+    logsBinaryAppend(&value, sizeof(value));
+  }
+
+  int8_t switches[16];
+  logsBinaryAppend(switches, getLogsSwitchesStates(switches));
+
+  if (LOGS_LOGICAL_SWITCHES_COLUMNS) {
+    uint32_t logicalSwitches[2] = { getLogicalSwitchesStates(32), getLogicalSwitchesStates(0) };
+    logsBinaryAppend(logicalSwitches, sizeof(logicalSwitches));
+  }
+
+  int32_t vbat = g_vbat100mV;
+  logsBinaryAppend(&vbat, sizeof(vbat));
+}
+
+void logsBinaryWriteBuffers()
+{
+  while (logsBuffers[logsWriteBuffer].full) {
+    LogsBuffer & buffer = logsBuffers[logsWriteBuffer];
+    UINT written;
+    FRESULT result = f_write(&g_oLogFile, buffer.data, buffer.size, &written);
+    if (result == FR_OK && written != buffer.size) {
+      result = FR_DENIED; // SD card full
+    }
+    if (result != FR_OK) {
+      logsWriteResult = result;
+    }
+    buffer.size = 0;
+    buffer.full = false;
+    logsWriteBuffer ^= 1;
+  }
+}
+
+// the full buffers are written first, then the current (partial) one
+void logsBinaryClose()
+{
+  logsBinaryWriteBuffers();
+  LogsBuffer & buffer = logsBuffers[logsCurrentBuffer];
+  if (buffer.size > 0) {
+    UINT written;
+    f_write(&g_oLogFile, buffer.data, buffer.size, &written);
+  }
+  buffer.size = 0;
+  if (f_close(&g_oLogFile) != FR_OK) {
+    // close failed, forget file
+    g_oLogFile.obj.fs = 0;
+  }
+}
+
+TASK_FUNCTION(logsTask)
+{
+  while (1) {
+    RTOS_WAIT_FLAG(logsFlag, 100);
+    RTOS_CLEAR_FLAG(logsFlag);
+    if (g_oLogFile.obj.fs) {
+      logsBinaryWriteBuffers();
+    }
+    if (logsCloseRequest) {
+      if (g_oLogFile.obj.fs) {
+        logsBinaryClose();
+      }
+      logsCloseRequest = false;
+    }
+#if defined(SIMU)
+    if (main_thread_running == 0)
+      break;
+#endif
+  }
+  TASK_RETURN();
+}
+#endif
+
 void logsWrite()
 {
   static const pm_char * error_displayed = NULL;
@@ -223,6 +557,13 @@ void logsWrite()
     if (lastLogTime == 0 || (tmr10ms_t)(tmr10ms - lastLogTime) >= (tmr10ms_t)logDelay*10) {
       lastLogTime = tmr10ms;
 
+#if defined(LOG_BINARY)
+      // the logs task has not closed the previous file yet
+      if (logsCloseRequest) {
+        return;
+      }
+#endif
+
       if (!g_oLogFile.obj.fs) {
         const pm_char * result = logsOpen();
         if (result != NULL) {
@@ -234,6 +575,14 @@ void logsWrite()
         }
       }
 
+#if defined(LOG_BINARY)
+      logsBinaryWriteRow(tmr10ms);
+      if (logsWriteResult != FR_OK && !error_displayed) {
+        error_displayed = STR_SDCARD_ERROR;
+        POPUP_WARNING(STR_SDCARD_ERROR);
+        logsClose();
+      }
+#else
 #if defined(RTCLOCK)
       {
         static struct gtm utm;
@@ -406,6 +755,7 @@ void logsWrite()
         POPUP_WARNING(STR_SDCARD_ERROR);
         logsClose();
       }
+#endif
     }
   }
   else {
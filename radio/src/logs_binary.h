@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _LOGS_BINARY_H_
+#define _LOGS_BINARY_H_
+
+#include "definitions.h"
+
+// Binary logs format (shared with Companion, little endian)
+//
+//  LogsBinaryHeader
+//  uint8_t types[columns]       one LogsBinaryColumnType per column
+//  char names[namesLength]      the header line of the CSV log, without the '\n'
+//  rows of rowSize bytes        LOGS_BINARY_ROW_MARKER, then the columns values in the same order as the types
+//
+// A new header is written each time the log file is opened again. A column
+// may give several CSV fields (i.e. Date,Time), the names are only used
+// to rebuild the CSV header.
+
+#define LOGS_BINARY_MAGIC              "OTXL"
+#define LOGS_BINARY_VERSION            1
+#define LOGS_BINARY_ROW_MARKER         0xA5
+
+PACK(struct LogsBinaryHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t columns;
+  uint16_t rowSize;
+  uint16_t namesLength;
+});
+
+enum LogsBinaryColumnType {
+  LOGS_COLUMN_TIME,                // uint32_t, 10ms ticks
+  LOGS_COLUMN_DATE_TIME,           // uint32_t seconds since 1970, uint8_t 1/100s => Date,Time
+  LOGS_COLUMN_VALUE,               // int32_t
+  LOGS_COLUMN_VALUE_PREC1,         // int32_t, 1 decimal
+  LOGS_COLUMN_VALUE_PREC2,         // int32_t, 2 decimals
+  LOGS_COLUMN_GPS,                 // int32_t latitude, int32_t longitude (1e-6 degrees)
+  LOGS_COLUMN_SENSOR_DATE_TIME,    // uint16_t year, uint8_t month, day, hour, min, sec
+  LOGS_COLUMN_ANALOG,              // int16_t
+  LOGS_COLUMN_SWITCH,              // int8_t
+  LOGS_COLUMN_LOGICAL_SWITCHES,    // uint32_t L33..L64, uint32_t L1..L32
+  LOGS_COLUMN_TYPES_COUNT
+};
+
+static const uint8_t LOGS_COLUMN_SIZES[LOGS_COLUMN_TYPES_COUNT] = {
+  4, // LOGS_COLUMN_TIME
+  5, // LOGS_COLUMN_DATE_TIME
+  4, // LOGS_COLUMN_VALUE
+  4, // LOGS_COLUMN_VALUE_PREC1
+  4, // LOGS_COLUMN_VALUE_PREC2
+  8, // LOGS_COLUMN_GPS
+  7, // LOGS_COLUMN_SENSOR_DATE_TIME
+  2, // LOGS_COLUMN_ANALOG
+  1, // LOGS_COLUMN_SWITCH
+  8, // LOGS_COLUMN_LOGICAL_SWITCHES
+};
+
+#endif // _LOGS_BINARY_H_
@@ -647,6 +647,7 @@ static int luaModelInsertMix(lua_State *L)
         mix->speedDown = luaL_checkinteger(L, -1);
       }
     }
+    storageDirty(EE_MODEL);
   }
 
   return 0;
@@ -688,6 +689,7 @@ Remove all mixers
 static int luaModelDeleteMixes(lua_State *L)
 {
   memset(g_model.mixData, 0, sizeof(g_model.mixData));
+  storageDirty(EE_MODEL);
   return 0;
 }
 
@@ -353,8 +353,9 @@ static int luaDumpWriter(lua_State * L, const void* p, size_t size, void* u)
   @param stripDebug This is passed directly to luaU_dump()
     1 = remove debug info from bytecode (smaller but errors are less informative)
     0 = keep debug info
+  @retval true when the file was written
 */
-static void luaDumpState(lua_State * L, const char * filename, const FILINFO * finfo, int stripDebug)
+static bool luaDumpState(lua_State * L, const char * filename, const FILINFO * finfo, int stripDebug)
 {
   FIL D;
   if (f_open(&D, filename, FA_WRITE | FA_CREATE_ALWAYS) == FR_OK) {
@@ -365,9 +366,121 @@ static void luaDumpState(lua_State * L, const char * filename, const FILINFO * f
       if (finfo != NULL)
         f_utime(filename, finfo);  // set the file mod time
       TRACE("luaDumpState(%s): Saved bytecode to file.", filename);
+      return true;
     }
   } else
     TRACE_ERROR("luaDumpState(%s): Error: Could not open output file.", filename);
+  return false;
+}
+
+/*
+  Index of the compiled scripts, read once from SCRIPTS_BYTECODE_INDEX.
+
+  Each entry records the size, the modification time and a hash of the content of the source
+  file used to build the .luac file. When the source file still matches its entry, the .luac
+  file is loaded without checking its own timestamp. When only its timestamp changed (i.e. the
+  same file was copied again), the content hash avoids a new compilation.
+*/
+#define LUA_BYTECODE_INDEX_VERSION     1
+#define LUA_BYTECODE_INDEX_ENTRIES     64
+
+PACK(struct LuaBytecodeIndexEntry {
+  uint32_t pathHash;
+  uint32_t size;
+  uint32_t mtime;
+  uint32_t contentHash;
+});
+
+static LuaBytecodeIndexEntry luaBytecodeIndex[LUA_BYTECODE_INDEX_ENTRIES];
+static bool luaBytecodeIndexLoaded = false;
+static uint8_t luaBytecodeIndexNext = 0;
+
+static void luaLoadBytecodeIndex()
+{
+  FIL file;
+  UINT read;
+  uint32_t version;
+
+  luaBytecodeIndexLoaded = true;
+  memclear(luaBytecodeIndex, sizeof(luaBytecodeIndex));
+
+  if (f_open(&file, SCRIPTS_BYTECODE_INDEX, FA_OPEN_EXISTING | FA_READ) != FR_OK)
+    return;
+
+  if (f_read(&file, &version, sizeof(version), &read) != FR_OK || read != sizeof(version) || version != LUA_BYTECODE_INDEX_VERSION ||
+      f_read(&file, luaBytecodeIndex, sizeof(luaBytecodeIndex), &read) != FR_OK || read != sizeof(luaBytecodeIndex)) {
+    TRACE("luaLoadBytecodeIndex(): index ignored");
+    memclear(luaBytecodeIndex, sizeof(luaBytecodeIndex));
+  }
+
+  f_close(&file);
+}
+
+static void luaSaveBytecodeIndex()
+{
+  FIL file;
+  UINT written;
+  uint32_t version = LUA_BYTECODE_INDEX_VERSION;
+
+  if (f_open(&file, SCRIPTS_BYTECODE_INDEX, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) {
+    TRACE_ERROR("luaSaveBytecodeIndex(): Error: Could not open index file.");
+    return;
+  }
+
+  f_write(&file, &version, sizeof(version), &written);
+  f_write(&file, luaBytecodeIndex, sizeof(luaBytecodeIndex), &written);
+  f_close(&file);
+}
+
+static LuaBytecodeIndexEntry * luaFindBytecodeIndexEntry(uint32_t pathHash)
+{
+  if (!luaBytecodeIndexLoaded) {
+    luaLoadBytecodeIndex();
+  }
+
+  for (uint8_t i=0; i<LUA_BYTECODE_INDEX_ENTRIES; i++) {
+    if (luaBytecodeIndex[i].pathHash == pathHash) {
+      return &luaBytecodeIndex[i];
+    }
+  }
+
+  return NULL;
+}
+
+static uint32_t luaHashFile(const char * filename)
+{
+  FIL file;
+  UINT read;
+  uint8_t buffer[128];
+  uint32_t hash = 5381;
+
+  if (f_open(&file, filename, FA_OPEN_EXISTING | FA_READ) != FR_OK)
+    return 0;
+
+  while (f_read(&file, buffer, sizeof(buffer), &read) == FR_OK && read > 0) {
+    hash = MathUtil::hash(buffer, read, hash);
+  }
+
+  f_close(&file);
+  return hash;
+}
+
+static void luaUpdateBytecodeIndex(uint32_t pathHash, const FILINFO * finfo, uint32_t contentHash)
+{
+  LuaBytecodeIndexEntry * entry = luaFindBytecodeIndexEntry(pathHash);
+  if (!entry) {
+    entry = luaFindBytecodeIndexEntry(0);
+  }
+  if (!entry) {
+    entry = &luaBytecodeIndex[luaBytecodeIndexNext];
+    luaBytecodeIndexNext = (luaBytecodeIndexNext + 1) % LUA_BYTECODE_INDEX_ENTRIES;
+  }
+
+  entry->pathHash = pathHash;
+  entry->size = finfo->fsize;
+  entry->mtime = (finfo->fdate << 16) + finfo->ftime;
+  entry->contentHash = contentHash;
+  luaSaveBytecodeIndex();
 }
 #endif  // LUA_COMPILER
 
@@ -387,6 +500,7 @@ static void luaDumpState(lua_State * L, const char * filename, const FILINFO * f
     "t" only text.
     "T" (default on simulator) prefer text but load binary if that is the only version available.
     "bt" (default on radio) either binary or text, whichever is newer (binary preferred when timestamps are equal).
+     The binary version is also used when the index of compiled scripts says it was built from the same text version.
     Add "x" to avoid automatic compilation of source file to .luac version.
       Eg: "tx", "bx", or "btx".
     Add "c" to force compilation of source file to .luac version (even if existing version is newer than source file).
@@ -440,16 +554,33 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
   }
   strncat(filenameFull, filename, fnamelen);
 
-  // check if binary version exists
-  strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
-  frLuaC = f_stat(filenameFull, &fnoLuaC);
-
   // check if text version exists
   strcpy(filenameFull + fnamelen, SCRIPT_EXT);
   frLuaS = f_stat(filenameFull, &fnoLuaS);
 
+  // the index tells if the binary version was built from this text version
+  uint32_t pathHash = MathUtil::hash(filenameFull, fnamelen);
+  LuaBytecodeIndexEntry * indexEntry = NULL;
+  if (frLuaS == FR_OK) {
+    indexEntry = luaFindBytecodeIndexEntry(pathHash);
+  }
+  bool binaryUpToDate = indexEntry && indexEntry->size == fnoLuaS.fsize && indexEntry->mtime == (uint32_t)((fnoLuaS.fdate << 16) + fnoLuaS.ftime);
+
+  // check if binary version exists
+  if (binaryUpToDate) {
+    frLuaC = FR_OK;
+  }
+  else {
+    strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
+    frLuaC = f_stat(filenameFull, &fnoLuaC);
+    strcpy(filenameFull + fnamelen, SCRIPT_EXT);
+  }
+
   // decide which version to load, text or binary
-  if (frLuaC != FR_OK && frLuaS == FR_OK) {
+  if (binaryUpToDate && !strchr(lmode, 'c')) {
+    loadFileType = strchr(lmode, 'b') ? 2 : 1;
+  }
+  else if (frLuaC != FR_OK && frLuaS == FR_OK) {
     // only text version exists
     loadFileType = 1;
     scriptNeedsCompile = true;
@@ -460,10 +591,19 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
   }
   else if (frLuaS == FR_OK) {
     // both versions exist, compare them
-    if (strchr(lmode, 'c') || (uint32_t)((fnoLuaC.fdate << 16) + fnoLuaC.ftime) < (uint32_t)((fnoLuaS.fdate << 16) + fnoLuaS.ftime)) {
-      // text version is newer than binary or forced by "c" mode flag, rebuild it
+    if (strchr(lmode, 'c')) {
+      // forced by "c" mode flag, rebuild it
       scriptNeedsCompile = true;
     }
+    else if ((uint32_t)((fnoLuaC.fdate << 16) + fnoLuaC.ftime) < (uint32_t)((fnoLuaS.fdate << 16) + fnoLuaS.ftime)) {
+      // text version is newer than binary, rebuild it unless its content didn't change
+      if (indexEntry && indexEntry->size == fnoLuaS.fsize && indexEntry->contentHash == luaHashFile(filenameFull)) {
+        luaUpdateBytecodeIndex(pathHash, &fnoLuaS, indexEntry->contentHash);
+      }
+      else {
+        scriptNeedsCompile = true;
+      }
+    }
     if (scriptNeedsCompile || !strchr(lmode, 'b')) {
       // text version needs compilation or forced by mode
       loadFileType = 1;
@@ -510,7 +650,8 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
   lstatus = luaL_loadfilex(L, filenameFull, NULL);
 #if defined(LUA_COMPILER)
   // Check for bytecode encoding problem, eg. compiled for x64. Unfortunately Lua doesn't provide a unique error code for this. See Lua/src/lundump.c.
-  if (lstatus == LUA_ERRSYNTAX && loadFileType == 2 && frLuaS == FR_OK && strstr(lua_tostring(L, -1), "precompiled")) {
+  // The binary version may also have been deleted since it was indexed.
+  if (loadFileType == 2 && frLuaS == FR_OK && (lstatus == LUA_ERRFILE || (lstatus == LUA_ERRSYNTAX && strstr(lua_tostring(L, -1), "precompiled")))) {
     loadFileType = 1;
     scriptNeedsCompile = true;
     strcpy(filenameFull + fnamelen, SCRIPT_EXT);
@@ -520,7 +661,10 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
   if (lstatus == LUA_OK) {
     if (scriptNeedsCompile && loadFileType == 1) {
       strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
-      luaDumpState(L, filenameFull, &fnoLuaS, (strchr(lmode, 'd') ? 0 : 1));
+      if (luaDumpState(L, filenameFull, &fnoLuaS, (strchr(lmode, 'd') ? 0 : 1))) {
+        strcpy(filenameFull + fnamelen, SCRIPT_EXT);
+        luaUpdateBytecodeIndex(pathHash, &fnoLuaS, luaHashFile(filenameFull));
+      }
     }
     ret = SCRIPT_OK;
   }
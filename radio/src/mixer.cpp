@@ -701,6 +701,59 @@ int getSourceTrimValue(int source, int stickValue=0)
 }
 #endif
 
+#if defined(CPUARM)
+MixPlan mixPlan;
+bool mixPlanDirty = true;
+
+void compileMixPlan()
+{
+  mixPlanDirty = false;
+
+  uint8_t count = 0;
+  for (uint8_t i=0; i<MAX_MIXERS; i++) {
+    MixData * md = mixAddress(i);
+    if (md->srcRaw == 0)
+      continue;
+
+    MixPlanOp & op = mixPlan.ops[count++];
+    op.index = i;
+    op.firstOfChannel = (i == 0 || (md-1)->srcRaw == 0 || md->destCh != (md-1)->destCh);
+
+    int srcChannel = md->srcRaw - MIXSRC_CH1;
+    if (srcChannel >= 0 && srcChannel <= MIXSRC_LAST_CH-MIXSRC_CH1 && srcChannel != md->destCh)
+      op.srcChannel = srcChannel;
+    else
+      op.srcChannel = MIX_PLAN_NO_CHANNEL;
+
+    // a line disabled by the flight mode still acts on its channel when it has a delay or a slow down
+    if (md->delayUp || md->delayDown || ((md->speedUp || md->speedDown) && md->mltpx != MLTPX_REP))
+      op.skippedFlightModes = 0;
+    else
+      op.skippedFlightModes = md->flightModes;
+  }
+  mixPlan.count = count;
+
+  // the channels to evaluate again in each pass only depend on the lines sources / destinations,
+  // so they are found once here instead of on each mixer run
+  bitfield_channels_t dirtyChannels = (bitfield_channels_t)-1; // all dirty when mixer starts
+  uint8_t pass = 0;
+  do {
+    mixPlan.passChannels[pass] = dirtyChannels;
+    bitfield_channels_t passDirtyChannels = 0;
+    for (uint8_t k=0; k<count; k++) {
+      const MixPlanOp & op = mixPlan.ops[k];
+      uint8_t destCh = mixAddress(op.index)->destCh;
+      if (op.srcChannel == MIX_PLAN_NO_CHANNEL || !(dirtyChannels & ((bitfield_channels_t)1 << destCh)))
+        continue;
+      if (dirtyChannels & ((bitfield_channels_t)1 << op.srcChannel) & (passDirtyChannels|~(((bitfield_channels_t) 1 << destCh)-1)))
+        passDirtyChannels |= (bitfield_channels_t) 1 << destCh;
+    }
+    dirtyChannels &= passDirtyChannels;
+  } while (++pass < MIX_PLAN_MAX_PASSES && dirtyChannels);
+  mixPlan.passes = pass;
+}
+#endif
+
 uint8_t mixerCurrentFlightMode;
 void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 {
@@ -799,6 +852,48 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
   uint8_t pass = 0;
 
+#if defined(CPUARM)
+  if (mixPlanDirty) {
+    compileMixPlan();
+  }
+
+  if (mode == e_perout_mode_normal) {
+    for (uint8_t i=0; i<MAX_MIXERS; i++) {
+      swOn[i].activeMix = 0;
+    }
+  }
+
+  // channels depending on channels evaluated later are evaluated again in the next passes, see compileMixPlan()
+  uint8_t passes = (mode > e_perout_mode_inactive_flight_mode ? 1 : mixPlan.passes);
+  ACTIVE_PHASES_TYPE flightModeMask = (ACTIVE_PHASES_TYPE)1 << mixerCurrentFlightMode;
+
+  do {
+
+    bitfield_channels_t dirtyChannels = mixPlan.passChannels[pass];
+
+    for (uint8_t k=0; k<mixPlan.count; k++) {
+
+      const MixPlanOp & op = mixPlan.ops[k];
+      uint8_t i = op.index;
+      MixData * md = mixAddress(i);
+
+      if (md->srcRaw == 0) continue; // line deleted, the plan will be compiled again on next run
+
+      if (!(dirtyChannels & ((bitfield_channels_t)1 << md->destCh))) continue;
+
+      // if this is the first calculation for the destination channel, initialize it with 0 (otherwise would be random)
+      if (op.firstOfChannel) {
+        chans[md->destCh] = 0;
+      }
+
+      // line disabled in this flight mode, and no delay / slow to run: it would not change the channel
+      if ((op.skippedFlightModes & flightModeMask) && !swOn[i].delay) {
+        if (mode == e_perout_mode_normal) {
+          swOn[i].now = swOn[i].prev = 0;
+        }
+        continue;
+      }
+#else
   bitfield_channels_t dirtyChannels = (bitfield_channels_t)-1; // all dirty when mixer starts
 
   do {
@@ -823,6 +918,7 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
       if (i == 0 || ((md-1)->srcRaw == 0) || (md->destCh != (md-1)->destCh) ) {
         chans[md->destCh] = 0;
       }
+#endif
 
       //========== FLIGHT MODE && SWITCH =====
       bool mixCondition = (md->flightModes != 0 || md->swtch);
@@ -864,6 +960,12 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 #endif
       }
       else {
+#if defined(CPUARM)
+        if (op.srcChannel != MIX_PLAN_NO_CHANNEL && (op.srcChannel < md->destCh || pass > 0))
+          v = chans[op.srcChannel] >> 8;
+        else
+          v = getValue(md->srcRaw);
+#else
 #if !defined(VIRTUAL_INPUTS)
         if (stickIndex < NUM_STICKS) {
           v = md->noExpo ? rawAnas[stickIndex] : anas[stickIndex];
@@ -881,6 +983,7 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
               v = chans[srcRaw] >> 8;
           }
         }
+#endif
         if (!mixCondition) {
           mixEnabled = v >> DELAY_POS_SHIFT;
         }
@@ -1116,9 +1219,13 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
     } //endfor mixers
 
     tick10ms = 0;
+#if defined(CPUARM)
+  } while (++pass < passes);
+#else
     dirtyChannels &= passDirtyChannels;
 
   } while (++pass < 5 && dirtyChannels);
+#endif
 
   mixWarning = lv_mixWarning;
 }
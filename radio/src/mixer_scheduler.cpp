@@ -35,6 +35,8 @@ struct MixerSchedule {
 
 static MixerSchedule mixerSchedules[NUM_MODULES];
 
+static volatile uint16_t mixerTriggerTime;
+
 uint16_t getMixerSchedulerPeriod()
 {
   uint16_t period = std::max(mixerSchedules[INTERNAL_MODULE].period, mixerSchedules[EXTERNAL_MODULE].period);
@@ -73,7 +75,13 @@ bool mixerSchedulerWaitForTrigger(uint8_t timeoutMs)
 
 void mixerSchedulerISRTrigger()
 {
+  mixerTriggerTime = getTmr2MHz();
   RTOS_ISR_SET_FLAG(mixerFlag);
 }
 
+uint16_t getMixerSchedulerTriggerTime()
+{
+  return mixerTriggerTime;
+}
+
 #endif
@@ -58,6 +58,9 @@ uint16_t getMixerSchedulerPeriod();
 // Trigger mixer from an ISR
 void mixerSchedulerISRTrigger();
 
+// Time (2MHz timer) of the last trigger
+uint16_t getMixerSchedulerTriggerTime();
+
 #else
 
 #define mixerSchedulerInit()
@@ -77,6 +80,7 @@ static inline bool mixerSchedulerWaitForTrigger(uint8_t timeout)
 
 #define getMixerSchedulerPeriod() (MIXER_SCHEDULER_DEFAULT_PERIOD_US)
 #define mixerSchedulerISRTrigger()
+#define getMixerSchedulerTriggerTime() getTmr2MHz()
 
 #endif
 
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "mixer_timings.h"
+
+TimingHistogram mixerTimings[MIXER_TIMINGS_COUNT] = {
+  TimingHistogram(50),   // MIXER_TIMING_TRIGGER_LATENCY
+  TimingHistogram(100),  // MIXER_TIMING_DURATION
+  TimingHistogram(50),   // MIXER_TIMING_INTERNAL_PULSES
+  TimingHistogram(50),   // MIXER_TIMING_EXTERNAL_PULSES
+  TimingHistogram(100),  // MIXER_TIMING_END_TO_END
+  TimingHistogram(25),   // MIXER_TIMING_PERIOD_JITTER
+};
+
+const char * const mixerTimingNames[MIXER_TIMINGS_COUNT] = {
+  "Trigger",
+  "Mixer",
+  "Int. pulses",
+  "Ext. pulses",
+  "End to end",
+  "Jitter",
+};
+
+void TimingHistogram::reset()
+{
+  min = UINT32_MAX;
+  max = 0;
+  count = 0;
+  total = 0;
+  memclear(buckets, sizeof(buckets));
+}
+
+void TimingHistogram::add(uint32_t duration)
+{
+  uint32_t index = duration / bucketWidth;
+  if (index >= TIMING_HISTOGRAM_BUCKETS)
+    index = TIMING_HISTOGRAM_BUCKETS - 1;
+  buckets[index]++;
+  if (duration < min)
+    min = duration;
+  if (duration > max)
+    max = duration;
+  total += duration;
+  count++;
+}
+
+uint32_t TimingHistogram::getPercentile(uint8_t percent) const
+{
+  if (!count)
+    return 0;
+
+  uint64_t threshold = ((uint64_t)count * percent + 99) / 100;
+  uint32_t sum = 0;
+  for (uint8_t i=0; i<TIMING_HISTOGRAM_BUCKETS-1; i++) {
+    sum += buckets[i];
+    if (sum >= threshold)
+      return (i + 1) * bucketWidth;
+  }
+  return max;
+}
+
+void mixerTimingsReset()
+{
+  for (uint8_t i=0; i<MIXER_TIMINGS_COUNT; i++) {
+    mixerTimings[i].reset();
+  }
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _MIXER_TIMINGS_H_
+#define _MIXER_TIMINGS_H_
+
+#include <inttypes.h>
+
+#define TIMING_HISTOGRAM_BUCKETS       16
+
+// Histogram of durations (us) with fixed size buckets, the last bucket also counts the longer samples
+class TimingHistogram
+{
+  public:
+    explicit TimingHistogram(uint16_t bucketWidth=100):
+      bucketWidth(bucketWidth)
+    {
+      reset();
+    }
+
+    void reset();
+    void add(uint32_t duration);
+
+    // upper bound (us) of the bucket where the given percentage of the samples is reached
+    uint32_t getPercentile(uint8_t percent) const;
+
+    uint16_t getBucketWidth() const { return bucketWidth; }
+    uint32_t getBucket(uint8_t index) const { return buckets[index]; }
+    uint32_t getCount() const { return count; }
+    uint32_t getMin() const { return count ? min : 0; }
+    uint32_t getMax() const { return max; }
+    uint32_t getAvg() const { return count ? total / count : 0; }
+
+  protected:
+    uint16_t bucketWidth;
+    uint32_t min;
+    uint32_t max;
+    uint32_t count;
+    uint64_t total;
+    uint32_t buckets[TIMING_HISTOGRAM_BUCKETS];
+};
+
+enum MixerTimings {
+  MIXER_TIMING_TRIGGER_LATENCY,   // scheduler trigger to mixer start
+  MIXER_TIMING_DURATION,          // mixer calculations
+  MIXER_TIMING_INTERNAL_PULSES,   // mixer end to internal module frame sent
+  MIXER_TIMING_EXTERNAL_PULSES,   // mixer end to external module frame sent
+  MIXER_TIMING_END_TO_END,        // scheduler trigger to last module frame sent
+  MIXER_TIMING_PERIOD_JITTER,     // difference between the scheduler period and the configured one
+  MIXER_TIMINGS_COUNT
+};
+
+extern TimingHistogram mixerTimings[MIXER_TIMINGS_COUNT];
+extern const char * const mixerTimingNames[MIXER_TIMINGS_COUNT];
+
+void mixerTimingsReset();
+
+#endif // _MIXER_TIMINGS_H_
@@ -647,10 +647,24 @@ void logicalSwitchesTimerTick();
 void logicalSwitchesReset();
 
 #if defined(CPUARM)
+  #define bitfield_logical_switches_t uint64_t
+  // Logical switches evaluation plan: the used switches in dependencies order,
+  // compiled again only when the model changes
+  struct LogicalSwitchesPlan {
+    uint8_t count;
+    uint8_t order[MAX_LOGICAL_SWITCHES];
+    bitfield_logical_switches_t inputs[MAX_LOGICAL_SWITCHES];  // logical switches read by each switch
+    bitfield_logical_switches_t derived;                       // switches only depending on logical switches evaluated before them
+  };
+  extern LogicalSwitchesPlan lsPlan;
+  extern bool lsPlanDirty;
+  void compileLogicalSwitchesPlan();
+  #define LS_PLAN_INVALIDATE()         lsPlanDirty = true
   void evalLogicalSwitches(bool isCurrentPhase=true);
   void logicalSwitchesCopyState(uint8_t src, uint8_t dst);
   #define LS_RECURSIVE_EVALUATION_RESET()
 #else
+  #define LS_PLAN_INVALIDATE()
   #define evalLogicalSwitches(xxx)
   #define GETSWITCH_RECURSIVE_TYPE uint16_t
   extern volatile GETSWITCH_RECURSIVE_TYPE s_last_switch_used;
@@ -957,6 +971,7 @@ point_t getPoint(uint8_t curveIndex, uint8_t index);
 typedef CurveData CurveInfo;
 void loadCurves();
 #define LOAD_MODEL_CURVES() loadCurves()
+void invalidateCurveTangents();
 int intpol(int x, uint8_t idx);
 int applyCurve(int x, CurveRef & curve);
 int applyCustomCurve(int x, uint8_t idx);
@@ -1065,6 +1080,34 @@ PACK(typedef struct {
 extern SwOn   swOn[MAX_MIXERS];
 extern int24_t act[MAX_MIXERS];
 
+#if defined(CPUARM)
+// Compiled mix plan: the used mix lines and the channels to evaluate in each mixer pass,
+// compiled again only when the model changes
+#define MIX_PLAN_MAX_PASSES            5
+#define MIX_PLAN_NO_CHANNEL            0xFF
+
+PACK(struct MixPlanOp {
+  uint8_t index;                          // line index in g_model.mixData
+  uint8_t srcChannel;                     // source channel, MIX_PLAN_NO_CHANNEL if the source is not another channel
+  uint8_t firstOfChannel;                 // first line of its destination channel
+  ACTIVE_PHASES_TYPE skippedFlightModes;  // flight modes where the line has no effect on its channel
+});
+
+struct MixPlan {
+  uint8_t count;
+  uint8_t passes;
+  bitfield_channels_t passChannels[MIX_PLAN_MAX_PASSES];
+  MixPlanOp ops[MAX_MIXERS];
+};
+
+extern MixPlan mixPlan;
+extern bool mixPlanDirty;
+void compileMixPlan();
+#define MIX_PLAN_INVALIDATE()          mixPlanDirty = true
+#else
+#define MIX_PLAN_INVALIDATE()
+#endif
+
 #if defined(BOLD_FONT)
   inline bool isExpoActive(uint8_t expo)
   {
@@ -1136,8 +1179,7 @@ void evalFunctions();
 #include "telemetry/telemetry.h"
 
 #if defined(CPUARM)
-uint8_t crc8(const uint8_t * ptr, uint32_t len);
-uint16_t crc16(const uint8_t * ptr, uint32_t len);
+#include "crc.h"
 #endif
 
 #define PLAY_REPEAT(x)            (x)                 /* Range 0 to 15 */
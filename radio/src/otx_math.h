@@ -212,11 +212,11 @@ class MathUtil
     }
   }
 
-  //! djb2 hash algorithm
-  static const uint32_t hash(const void * ptr, uint32_t size)
+  //! djb2 hash algorithm, pass the previous result as start to hash data in several chunks
+  static const uint32_t hash(const void * ptr, uint32_t size, uint32_t start = 5381)
   {
     const uint8_t * data = (const uint8_t *)ptr;
-    uint32_t hash = 5381;
+    uint32_t hash = start;
     for (uint32_t i=0; i<size; i++) {
       hash = ((hash << 5) + hash) + data[i]; /* hash * 33 + c */
     }
@@ -24,18 +24,7 @@
 #include <functional>
 #include <map>
 #include <list>
-
-struct FlySkySerialPulsesData {
-  uint8_t  pulses[72];
-  uint8_t  * ptr;
-  uint8_t  frame_index;
-  uint8_t  crc;
-  uint8_t  state;
-  uint8_t  timeout;
-  uint8_t  esc_state;
-  uint8_t  telemetry[64];
-  uint8_t  telemetry_index;
-} __attribute__((__packed__));
+#include "pulses_common.h"
 
 enum AfhdsSpecialChars {
   END = 0xC0,             //Frame end
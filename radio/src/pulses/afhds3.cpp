@@ -20,6 +20,7 @@
 
 
 #include "afhds3.h"
+#include "../crc.h"
 #include "../debug.h"
 #include "../definitions.h"
 #include "../translations.h"
@@ -108,41 +109,24 @@ void afhds3::getPowerSource(char* buffer) {
 }
 
 void afhds3::putByte(uint8_t byte) {
-  this->putBytes(&byte, 1);
+  data->addByte(byte);
 }
 
 void afhds3::putBytes(uint8_t* data, int length) {
-  for (int i = 0; i < length; i++) {
-    uint8_t byte = data[i];
-    this->data->crc += byte;
-    if (END == byte) {
-      *this->data->ptr++ = ESC;
-      *this->data->ptr++ = ESC_END;
-    }
-    else if (ESC == byte) {
-      *this->data->ptr++ = ESC;
-      *this->data->ptr++ = ESC_ESC;
-    }
-    else {
-      *this->data->ptr++ = byte;
-    }
-  }
+  this->data->addBytes(data, length);
 }
 
 void afhds3::putHeader(COMMAND command, FRAME_TYPE frame, uint8_t frameIndex) {
   operationState = State::SENDING_COMMAND;
-  data->ptr = this->data->pulses;
-  data->crc = 0;
-  *data->ptr++ = END;
+  data->initFrame();
   uint8_t buffer[] = { FrameAddress, frameIndex, frame, command};
   putBytes(buffer, 4);
 }
 
 
-void afhds3::putFooter() {
-  putByte(data->crc ^ 0xff);
-  *data->ptr++ = END;
-  switch((FRAME_TYPE)data->pulses[3])
+void afhds3::putFooter(FRAME_TYPE frameType) {
+  data->endFrame();
+  switch(frameType)
   {
     case FRAME_TYPE::REQUEST_GET_DATA:
     case FRAME_TYPE::REQUEST_SET_EXPECT_ACK:
@@ -162,16 +146,16 @@ void afhds3::putFrame(COMMAND command, FRAME_TYPE frameType, uint8_t* payload, u
   putHeader(command, frameType, *frameIndex);
   if(dataLength > 0) putBytes(payload, dataLength);
   *frameIndex = *frameIndex + 1;
-  putFooter();
+  putFooter(frameType);
 }
 
 bool checkCRC(const uint8_t* data, uint8_t size)
 {
-  uint8_t crc = 0;
-  //skip start byte
-  for (uint8_t i = 1; i < size; i++) {
-    crc += data[i];
+  if (size == 0) {
+    return false;
   }
+  //skip start byte
+  uint8_t crc = checksum8(data + 1, size - 1);
   return (crc ^ 0xff) == data[size];
 }
 
@@ -211,7 +195,7 @@ void afhds3::parseData(uint8_t* rxBuffer, uint8_t rxBufferCount) {
     return;
   }
   AfhdsFrame* responseFrame = reinterpret_cast<AfhdsFrame*>(rxBuffer);
-  AfhdsFrame* requestFrame = reinterpret_cast<AfhdsFrame*>(data->pulses);
+  const AfhdsFrame* requestFrame = reinterpret_cast<const AfhdsFrame*>(data->getData());
   uint8_t oldState = data->state;
   if(containsData((enum FRAME_TYPE)responseFrame->frameType)) {
     switch(responseFrame->command)
@@ -357,11 +341,12 @@ void afhds3::onDataReceived(uint8_t byte, uint8_t* rxBuffer, uint8_t& rxBufferCo
 void afhds3::trace(const char* message) {
   char buffer[256];
   char *pos = buffer;
-  for (int i = 0; i < data->ptr - data->pulses; i++) {
-    pos += std::snprintf(pos, buffer + sizeof(buffer) - pos, "%02X ", data->pulses[i]);
+  const uint8_t* frame = data->getData();
+  for (int i = 0; i < data->getSize(); i++) {
+    pos += std::snprintf(pos, buffer + sizeof(buffer) - pos, "%02X ", frame[i]);
   }
   (*pos) = 0;
-  TRACE("%s size = %d data %s", message, data->ptr - data->pulses, buffer);
+  TRACE("%s size = %d data %s", message, data->getSize(), buffer);
 }
 
 bool afhds3::isConnectedUnicast() {
@@ -381,14 +366,14 @@ void afhds3::setupPulses() {
       return;
     }
     else {
-        TRACE("AFHDS3 [NO RESP] Frame %02X", data->pulses[3]);
+        TRACE("AFHDS3 [NO RESP] Frame %02X", data->getData()[3]);
         reset(false);
     }
   }
   else if(operationState == State::UNKNOWN){
     data->state = ModuleState::STATE_NOT_READY;
   }
-  data->ptr = data->pulses;
+  data->clearFrame();
   repeatCount = 0;
   if (data->state == ModuleState::STATE_NOT_READY) {
     TRACE("AFHDS3 [GET MODULE READY]");
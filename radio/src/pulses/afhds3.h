@@ -180,6 +180,24 @@ union Config_u {
   uint8_t buffer[sizeof(Config_s)];
 };
 
+}
+
+// every byte escaped: END + (4 header bytes + AFHDS3 configuration + checksum) * 2 + END
+#define FLYSKY_PULSES_SIZE (2 + (4 + sizeof(afhds3::Config_s) + 1) * 2)
+
+static_assert(FLYSKY_PULSES_SIZE <= 255, "the SLIP frame size has to fit in uint8_t");
+
+struct FlySkySerialPulsesData: public SlipFramesBuffer<FLYSKY_PULSES_SIZE> {
+  uint8_t  frame_index;
+  uint8_t  state;
+  uint8_t  timeout;
+  uint8_t  esc_state;
+  uint8_t  telemetry[64];
+  uint8_t  telemetry_index;
+} __attribute__((__packed__));
+
+namespace afhds3 {
+
 enum CHANNELS_DATA_MODE {
   CHANNELS = 0x01, FAIL_SAFE = 0x02,
 };
@@ -195,6 +213,9 @@ union ChannelsData_u {
   uint8_t buffer[sizeof(ChannelsData)];
 };
 
+// the configuration is the largest frame sent to the module (FLYSKY_PULSES_SIZE)
+static_assert(sizeof(ChannelsData) <= sizeof(Config_s), "the channels frame does not fit in the pulses buffer");
+
 struct __attribute__ ((packed)) TelemetryData {
   uint8_t sensorType;
   uint8_t length;
@@ -333,7 +354,7 @@ private:
   inline void putByte(uint8_t byte);
   inline void putBytes(uint8_t* data, int length);
   inline void putHeader(COMMAND command, FRAME_TYPE frameType, uint8_t frameIndex);
-  inline void putFooter();
+  inline void putFooter(FRAME_TYPE frameType);
   inline void putFrame(COMMAND command, FRAME_TYPE frameType, uint8_t* data = nullptr, uint8_t dataLength = 0, uint8_t* frame_index = nullptr);
   void parseData(uint8_t* rxBuffer, uint8_t rxBufferCount);
   void setState(uint8_t state);
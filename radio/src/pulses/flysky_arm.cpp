@@ -198,52 +198,25 @@ void onFlySkyGetVersionInfoStart(uint8_t isRfTransfer)
   setFlyskyState(isRfTransfer ? STATE_GET_RF_VERSION_INFO : STATE_GET_RX_VERSION_INFO);
 }
 
-inline void initFlySkyArray()
-{
-  intmodulePulsesData.flysky.ptr = intmodulePulsesData.flysky.pulses;
-  intmodulePulsesData.flysky.crc = 0;
-}
-
-inline void putFlySkyByte(uint8_t byte)
-{
-  if (END == byte) {
-    *intmodulePulsesData.flysky.ptr++ = ESC;
-    *intmodulePulsesData.flysky.ptr++ = ESC_END;
-  }
-  else if (ESC == byte) {
-    *intmodulePulsesData.flysky.ptr++ = ESC;
-    *intmodulePulsesData.flysky.ptr++ = ESC_ESC;
-  }
-  else {
-    *intmodulePulsesData.flysky.ptr++ = byte;
-  }
-}
-
 inline void putFlySkyFrameByte(uint8_t byte)
 {
-  intmodulePulsesData.flysky.crc += byte;
-  putFlySkyByte(byte);
+  intmodulePulsesData.flysky.addByte(byte);
 }
 
 inline void putFlySkyFrameCmd(uint8_t type, uint8_t cmd)
 {
-  intmodulePulsesData.flysky.crc += type + cmd;
-  putFlySkyByte(type);
-  putFlySkyByte(cmd);
+  intmodulePulsesData.flysky.addByte(type);
+  intmodulePulsesData.flysky.addByte(cmd);
 }
 
 inline void putFlySkyFrameBytes(uint8_t* data, int length)
 {
-  for(int i = 0; i < length; i++) {
-    intmodulePulsesData.flysky.crc += data[i];
-    putFlySkyByte(data[i]);
-  }
+  intmodulePulsesData.flysky.addBytes(data, length);
 }
 
 inline void putFlySkyFrameHeader()
 {
-  initFlySkyArray();
-  *intmodulePulsesData.flysky.ptr++ = END;
+  intmodulePulsesData.flysky.initFrame();
   putFlySkyFrameByte(intmodulePulsesData.flysky.frame_index);
 }
 
@@ -252,8 +225,7 @@ inline void putFlySkyFrameFooter()
   if (++intmodulePulsesData.flysky.frame_index == 0) {
     intmodulePulsesData.flysky.frame_index = 1;
   }
-  putFlySkyByte(intmodulePulsesData.flysky.crc ^ 0xff);
-  *intmodulePulsesData.flysky.ptr++ = END;
+  intmodulePulsesData.flysky.endFrame();
 }
 
 void afhds2Command(uint8_t type, uint8_t cmd)
@@ -268,6 +240,9 @@ inline void putFlySkySendChannelData()
   uint16_t pulseValue = 0;
   uint8_t channels_start = g_model.moduleData[INTERNAL_MODULE].channelsStart;
   uint8_t channels_last = channels_start + 8 + g_model.moduleData[INTERNAL_MODULE].channelsCount;
+  // the channels values are added at once (little endian), most of the time none of them needs to be escaped
+  uint16_t values[MAX_OUTPUT_CHANNELS];
+  uint8_t count = 0;
   putFlySkyFrameCmd(FRAME_TYPE_REQUEST_NACK, CMD_SEND_CHANNEL_DATA);
   if ( failsafeCounter[INTERNAL_MODULE]-- == 0 ) {
     failsafeCounter[INTERNAL_MODULE] = FAILSAVE_SEND_COUNTER_MAX;
@@ -286,8 +261,7 @@ inline void putFlySkySendChannelData()
         int16_t failsafeValue = -1024 + 2*PPM_CH_CENTER(channel) - 2*PPM_CENTER;
         pulseValue = limit<uint16_t>(0, 988 + ((failsafeValue + 1024) / 2), 0xfff);
       }
-      putFlySkyFrameByte(pulseValue & 0xff);
-      putFlySkyFrameByte(pulseValue >> 8);
+      values[count++] = pulseValue;
     }
     if (DEBUG_RF_FRAME_PRINT & RF_FRAME_ONLY) {
         TRACE("------FAILSAFE------");
@@ -299,10 +273,10 @@ inline void putFlySkySendChannelData()
     for (uint8_t channel = channels_start; channel < channels_last; channel++) {
       int channelValue = channelOutputs[channel] + 2*PPM_CH_CENTER(channel) - 2*PPM_CENTER;
       pulseValue = limit<uint16_t>(0, 988 + ((channelValue + 1024) / 2), 0xfff);
-      putFlySkyFrameByte(pulseValue & 0xff);
-      putFlySkyFrameByte(pulseValue >> 8);
+      values[count++] = pulseValue;
     }
   }
+  putFlySkyFrameBytes((uint8_t *)values, count * sizeof(uint16_t));
 }
 
 void putFlySkyUpdateFirmwareStart(uint8_t cmd)
@@ -312,11 +286,7 @@ void putFlySkyUpdateFirmwareStart(uint8_t cmd)
 
 bool checkFlySkyFrameCrc(const uint8_t * ptr, uint8_t size)
 {
-  uint8_t crc = 0;
-
-  for (uint8_t i = 0; i < size; i++) {
-    crc += ptr[i];
-  }
+  uint8_t crc = checksum8(ptr, size);
 
   if (DEBUG_RF_FRAME_PRINT & RF_FRAME_ONLY) {
     if (ptr[2] != 0x06 || (set_loop_cnt++ % 50 == 0)) {
@@ -648,11 +618,11 @@ void setupPulsesAFHDS2()
         }
         break;
         case STATE_IDLE:
-          initFlySkyArray();
+          intmodulePulsesData.flysky.clearFrame();
           break;
         default:
           setFlyskyState(STATE_INIT);
-          initFlySkyArray();
+          intmodulePulsesData.flysky.clearFrame();
           if ((DEBUG_RF_FRAME_PRINT & TX_FRAME_ONLY)) {
             TRACE("State back to INIT\r\n");
           }
@@ -660,7 +630,7 @@ void setupPulsesAFHDS2()
       }
     }
     else {
-      initFlySkyArray();
+      intmodulePulsesData.flysky.clearFrame();
       return;
     }
   }
@@ -673,14 +643,14 @@ void setupPulsesAFHDS2()
 
 
   if(intmodulePulsesData.flysky.state < STATE_SEND_CHANNELS) {
-    //uint8_t size = intmodulePulsesData.flysky.ptr - intmodulePulsesData.flysky.pulses;
-    //debugFrame(intmodulePulsesData.flysky.pulses, size);
+    //uint8_t size = intmodulePulsesData.flysky.getSize();
+    //debugFrame(intmodulePulsesData.flysky.getData(), size);
   }
   if ((DEBUG_RF_FRAME_PRINT & TX_FRAME_ONLY)) {
     /* print each command, except channel data by interval */
-    uint8_t * data = intmodulePulsesData.flysky.pulses;
+    const uint8_t * data = intmodulePulsesData.flysky.getData();
     if (data[3] != CMD_SEND_CHANNEL_DATA || (set_loop_cnt++ % 100 == 0)) {
-      uint8_t size = intmodulePulsesData.flysky.ptr - data;
+      uint8_t size = intmodulePulsesData.flysky.getSize();
       TRACE_NOCRLF("TX(State%0d)%0dB:", intmodulePulsesData.flysky.state, size);
       for (int idx = 0; idx < size; idx++) {
         TRACE_NOCRLF(" %02X", data[idx]);
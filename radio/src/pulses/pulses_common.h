@@ -22,6 +22,7 @@
 #define _PULSES_COMMON_H_
 
 #include <inttypes.h>
+#include <string.h>
 
 #if defined(EXTMODULE_TIMER_32BITS)
   typedef uint32_t pulse_duration_t;
@@ -88,4 +89,102 @@ class PulsesBuffer: public DataBuffer<T, SIZE> {
     }
 };
 
+// SLIP style frames (FlySky modules): END, the escaped frame bytes, the escaped checksum (inverted sum of the frame bytes), END
+#define SLIP_END                           0xC0
+#define SLIP_ESC                           0xDB
+#define SLIP_ESC_END                       0xDC
+#define SLIP_ESC_ESC                       0xDD
+
+// Two buffers, a frame is built in one while the previous frame may still be sent by DMA from the other
+template <int SIZE>
+class SlipFramesBuffer {
+  public:
+    const uint8_t * getData()
+    {
+      return data[current];
+    }
+
+    uint8_t getSize()
+    {
+      return ptr - data[current];
+    }
+
+    // nothing to send
+    void clearFrame()
+    {
+      ptr = data[current];
+    }
+
+    void initFrame()
+    {
+      current ^= 1;
+      ptr = data[current];
+      crc = 0;
+      *ptr++ = SLIP_END;
+    }
+
+    void addByte(uint8_t byte)
+    {
+      crc += byte;
+      addEscapedByte(byte);
+    }
+
+    // 4 bytes at a time when none of them needs to be escaped (i.e. the channels values)
+    void addBytes(const uint8_t * bytes, uint32_t count)
+    {
+      for (; count >= 4; bytes += 4, count -= 4) {
+        uint32_t value;
+        memcpy(&value, bytes, 4);
+        if (hasByte(value, SLIP_END) || hasByte(value, SLIP_ESC)) {
+          for (uint8_t i=0; i<4; i++) {
+            addByte(bytes[i]);
+          }
+        }
+        else {
+          memcpy(ptr, &value, 4);
+          ptr += 4;
+          // the low byte of the sum is the sum of the 4 bytes
+          crc += value + (value >> 8) + (value >> 16) + (value >> 24);
+        }
+      }
+      while (count--) {
+        addByte(*bytes++);
+      }
+    }
+
+    void endFrame()
+    {
+      addEscapedByte(crc ^ 0xFF);
+      *ptr++ = SLIP_END;
+    }
+
+  protected:
+    uint8_t data[2][SIZE];
+    uint8_t * ptr;
+    uint8_t current;
+    uint8_t crc;
+
+    void addEscapedByte(uint8_t byte)
+    {
+      if (byte == SLIP_END) {
+        *ptr++ = SLIP_ESC;
+        *ptr++ = SLIP_ESC_END;
+      }
+      else if (byte == SLIP_ESC) {
+        *ptr++ = SLIP_ESC;
+        *ptr++ = SLIP_ESC_ESC;
+      }
+      else {
+        *ptr++ = byte;
+      }
+    }
+
+    // true when one of the 4 bytes of value is equal to byte
+    static inline bool hasByte(uint32_t value, uint8_t byte)
+    {
+      uint32_t x = value ^ (0x01010101u * byte);
+      return ((x - 0x01010101u) & ~x & 0x80808080u) != 0;
+    }
+};
+
 #endif
@@ -44,17 +44,20 @@
 #define SCRIPTS_MIXES_PATH  SCRIPTS_PATH "/MIXES"
 #define SCRIPTS_FUNCS_PATH  SCRIPTS_PATH "/FUNCTIONS"
 #define SCRIPTS_TELEM_PATH  SCRIPTS_PATH "/TELEMETRY"
+#define SCRIPTS_BYTECODE_INDEX  SCRIPTS_PATH "/luac.idx"
 
 #define LEN_FILE_PATH_MAX   (sizeof(SCRIPTS_TELEM_PATH)+1)  // longest + "/"
 
 #if defined(COLORLCD)
 const char RADIO_MODELSLIST_PATH[] = RADIO_PATH "/models.txt";
+const char RADIO_MODELSINDEX_PATH[] = RADIO_PATH "/models.idx";
 const char RADIO_SETTINGS_PATH[] = RADIO_PATH "/radio.bin";
 #define    SPLASH_FILE             "splash.png"
 #endif
 
 #define MODELS_EXT          ".bin"
 #define LOGS_EXT            ".csv"
+#define LOGS_BINARY_EXT     ".otl"
 #define SOUNDS_EXT          ".wav"
 #define BMP_EXT             ".bmp"
 #define PNG_EXT             ".png"
@@ -99,6 +102,11 @@ extern uint8_t logDelay;
 void logsInit();
 void logsClose();
 void logsWrite();
+#if defined(LOG_BINARY)
+extern RTOS_FLAG_HANDLE logsFlag;
+extern uint32_t logsOverruns;
+TASK_FUNCTION(logsTask);
+#endif
 
 bool sdCardFormat();
 uint32_t sdGetNoSectors();
@@ -22,18 +22,47 @@
 #define _MODELSLIST_H_
 
 #include <list>
+#include <vector>
+#include <algorithm>
 #include "sdcard.h"
 
 #define MODELCELL_WIDTH                (LCD_W - 40)
 #define MODELCELL_HEIGHT               86
 
+// Models metadata index (RADIO_MODELSINDEX_PATH)
+//
+// A ModelsIndexHeader, then one ModelsIndexEntry per model of the list. An
+// entry is used as long as the date and time of its model file are unchanged,
+// otherwise the model file is read again and the index rewritten. This avoids
+// opening every model file each time the models list is loaded.
+
+#define MODELS_INDEX_MAGIC             "OTXM"
+#define MODELS_INDEX_VERSION           1
+
+PACK(struct ModelsIndexHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t spare;
+  uint16_t entrySize;
+  uint16_t count;
+});
+
+PACK(struct ModelsIndexEntry {
+  char filename[LEN_MODEL_FILENAME];
+  uint16_t fdate;
+  uint16_t ftime;
+  ModelHeader header;
+});
+
 class ModelCell
 {
   public:
     ModelCell(const char * name):
-      buffer(NULL)
+      buffer(NULL),
+      infoValid(false)
     {
       strncpy(this->modelFilename, name, sizeof(this->modelFilename));
+      memclear(&info, sizeof(info));
     }
 
     ~ModelCell()
@@ -51,10 +80,34 @@ class ModelCell
       return buffer;
     }
 
+    // reads the index entry from the model file (the file date and time are set by the models list)
+    bool fetchInfo()
+    {
+      char path[256];
+      FIL file;
+      uint16_t size;
+      UINT read;
+
+      infoValid = false;
+      strncpy(info.filename, modelFilename, LEN_MODEL_FILENAME);
+
+      getModelPath(path, modelFilename);
+      if (openFile(path, &file, &size)) {
+        return false;
+      }
+
+      if (f_read(&file, &info.header, sizeof(info.header), &read) == FR_OK && read == sizeof(info.header)) {
+        infoValid = true;
+      }
+
+      f_close(&file);
+      return infoValid;
+    }
+
     void load()
     {
       ModelHeader header;
-      const char * error = NULL;
+      bool error = false;
 
       buffer = new BitmapBuffer(BMP_RGB565, MODELCELL_WIDTH, MODELCELL_HEIGHT);
       if (buffer == NULL) {
@@ -63,8 +116,10 @@ class ModelCell
 
       if (strncmp(modelFilename, g_eeGeneral.currModelFilename, LEN_MODEL_FILENAME) == 0)
         header = g_model.header;
+      else if (infoValid || fetchInfo())
+        header = info.header;
       else
-        error = readModel(modelFilename, (uint8_t *)&header, sizeof(header));
+        error = true;
 
       buffer->clear(TEXT_BGCOLOR);
 
@@ -104,6 +159,8 @@ class ModelCell
     char modelFilename[LEN_MODEL_FILENAME+1];
     char modelName[LEN_MODEL_NAME+1];
     BitmapBuffer * buffer;
+    ModelsIndexEntry info;
+    bool infoValid;
 };
 
 class ModelsCategory: public std::list<ModelCell *>
@@ -238,9 +295,141 @@ class ModelsList
         categories.push_back(category);
       }
 
+      loadIndex();
+
       return true;
     }
 
+    static bool compareFilenames(const ModelCell * first, const ModelCell * second)
+    {
+      return strncmp(first->modelFilename, second->modelFilename, LEN_MODEL_FILENAME) < 0;
+    }
+
+    static ModelCell * findModel(const std::vector<ModelCell *> & models, const char * filename)
+    {
+      auto it = std::lower_bound(models.begin(), models.end(), filename, [](const ModelCell * model, const char * name) {
+        return strncmp(model->modelFilename, name, LEN_MODEL_FILENAME) < 0;
+      });
+      if (it != models.end() && !strncmp((*it)->modelFilename, filename, LEN_MODEL_FILENAME)) {
+        return *it;
+      }
+      return NULL;
+    }
+
+    void loadIndex()
+    {
+      DIR dir;
+      FILINFO fno;
+
+      // the models sorted by filename, for the lookups of the directory and index entries
+      std::vector<ModelCell *> models;
+      models.reserve(modelsCount);
+      for (std::list<ModelsCategory *>::iterator it = categories.begin(); it != categories.end(); ++it) {
+        models.insert(models.end(), (*it)->begin(), (*it)->end());
+      }
+      std::sort(models.begin(), models.end(), compareFilenames);
+
+      // the current date and time of the model files
+      if (f_opendir(&dir, MODELS_PATH) == FR_OK) {
+        while (f_readdir(&dir, &fno) == FR_OK && fno.fname[0] != 0) {
+          ModelCell * model = findModel(models, fno.fname);
+          if (model) {
+            model->info.fdate = fno.fdate;
+            model->info.ftime = fno.ftime;
+          }
+        }
+        f_closedir(&dir);
+      }
+
+      bool changed = true;
+      if (f_open(&file, RADIO_MODELSINDEX_PATH, FA_OPEN_EXISTING | FA_READ) == FR_OK) {
+        ModelsIndexHeader header;
+        UINT read;
+        if (f_read(&file, &header, sizeof(header), &read) == FR_OK && read == sizeof(header) &&
+            !memcmp(header.magic, MODELS_INDEX_MAGIC, sizeof(header.magic)) && header.version == MODELS_INDEX_VERSION && header.entrySize == sizeof(ModelsIndexEntry)) {
+          ModelsIndexEntry entry;
+          uint16_t count = 0;
+          for (uint16_t i=0; i<header.count; i++) {
+            if (f_read(&file, &entry, sizeof(entry), &read) != FR_OK || read != sizeof(entry)) {
+              break;
+            }
+            ModelCell * model = findModel(models, entry.filename);
+            if (model && !model->infoValid && model->info.fdate == entry.fdate && model->info.ftime == entry.ftime) {
+              model->info = entry;
+              model->infoValid = true;
+              count++;
+            }
+          }
+          // otherwise some entries are outdated or of models which are not in the list any more
+          changed = (count != header.count);
+        }
+        f_close(&file);
+      }
+
+      for (std::list<ModelsCategory *>::iterator it = categories.begin(); it != categories.end(); ++it) {
+        for (ModelsCategory::iterator model = (*it)->begin(); model != (*it)->end(); ++model) {
+          if (!(*model)->infoValid) {
+            TRACE("models index: %s changed", (*model)->modelFilename);
+            if ((*model)->fetchInfo()) {
+              changed = true;
+            }
+          }
+        }
+      }
+
+      if (changed) {
+        saveIndex();
+      }
+    }
+
+    void saveIndex()
+    {
+      ModelsIndexHeader header;
+      memcpy(header.magic, MODELS_INDEX_MAGIC, sizeof(header.magic));
+      header.version = MODELS_INDEX_VERSION;
+      header.spare = 0;
+      header.entrySize = sizeof(ModelsIndexEntry);
+      header.count = 0;
+      for (std::list<ModelsCategory *>::iterator it = categories.begin(); it != categories.end(); ++it) {
+        for (ModelsCategory::iterator model = (*it)->begin(); model != (*it)->end(); ++model) {
+          if ((*model)->infoValid) {
+            header.count++;
+          }
+        }
+      }
+
+      if (f_open(&file, RADIO_MODELSINDEX_PATH, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) {
+        return;
+      }
+
+      UINT written;
+      f_write(&file, &header, sizeof(header), &written);
+      for (std::list<ModelsCategory *>::iterator it = categories.begin(); it != categories.end(); ++it) {
+        for (ModelsCategory::iterator model = (*it)->begin(); model != (*it)->end(); ++model) {
+          if ((*model)->infoValid) {
+            f_write(&file, &(*model)->info, sizeof(ModelsIndexEntry), &written);
+          }
+        }
+      }
+
+      f_close(&file);
+    }
+
+    // reads the index entry of a model which file has just been written
+    void updateModel(ModelCell * model)
+    {
+      char path[256];
+      FILINFO fno;
+
+      getModelPath(path, model->modelFilename);
+      if (f_stat(path, &fno) == FR_OK) {
+        model->info.fdate = fno.fdate;
+        model->info.ftime = fno.ftime;
+      }
+      model->fetchInfo();
+      saveIndex();
+    }
+
     unsigned int getModelIndex(ModelCell * model)
     {
       auto it = std::find(currentCategory->begin(), currentCategory->end(), model);
@@ -249,6 +438,10 @@ class ModelsList
 
     void setCurrentModel(ModelCell * model)
     {
+      // the previous model has been saved before the switch
+      if (currentModel && currentModel != model) {
+        updateModel(currentModel);
+      }
       currentModel = model;
     }
 
@@ -296,6 +489,7 @@ class ModelsList
       ModelCell * result = category->addModel(name);
       modelsCount++;
       save();
+      updateModel(result);
       return result;
     }
 
@@ -304,6 +498,7 @@ class ModelsList
       modelsCount -= category->size();
       delete category;
       categories.remove(category);
+      saveIndex();
     }
 
     void removeModel(ModelsCategory * category, ModelCell * model)
@@ -311,6 +506,7 @@ class ModelsList
       category->removeModel(model);
       modelsCount--;
       save();
+      saveIndex();
     }
 
     void moveModel(ModelsCategory * category, ModelCell * model, int8_t step)
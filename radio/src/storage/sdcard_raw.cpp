@@ -61,45 +61,283 @@ const char * writeFile(const char * filename, const uint8_t * data, uint16_t siz
   return NULL;
 }
 
+// Model journal
+//
+// The changes of the current model are appended to a journal next to the
+// model file (same name, MODEL_JOURNAL_EXT extension) instead of rewriting
+// the whole model file each time a trim or a setting is changed. The model
+// file stays the canonical format, the journal only applies to the model
+// file content it was started from (its CRC is in the header).
+//
+// Each record is a ModelJournalRecord, the data, then a crc16 of both. The
+// journal is replayed when the model is loaded and compacted into the model
+// file (full write, journal removed) after a replay, when it is full and
+// each time the model is saved immediately (model switch, power off).
+
+#define MODEL_JOURNAL_EXT              ".jnl"
+#define MODEL_JOURNAL_MAGIC            "OTXJ"
+#define MODEL_JOURNAL_MAX_SIZE         4096
+// changed ranges closer than this are written as one record
+#define MODEL_JOURNAL_MERGE_GAP        8
+
+PACK(struct ModelJournalHeader {
+  char magic[4];
+  uint16_t modelSize;
+  uint16_t modelCrc;
+});
+
+PACK(struct ModelJournalRecord {
+  uint16_t offset;
+  uint16_t size;
+});
+
+// the model as it is on the SD card (model file + journal)
+static ModelData savedModel __SDRAM;
+// g_model may be changed by the mixer task (trims) while it is being saved,
+// the diff, the write and savedModel use this copy taken once
+static ModelData modelSnapshot __SDRAM;
+static char savedModelFilename[LEN_MODEL_FILENAME+1];
+static uint32_t modelJournalSize = 0;
+
+static void getModelJournalPath(char * path, const char * filename)
+{
+  getModelPath(path, filename);
+  char * ext = strrchr(path, '.');
+  strcpy(ext && ext > strrchr(path, '/') ? ext : path + strlen(path), MODEL_JOURNAL_EXT);
+}
+
+static void setSavedModel(const ModelData * model, const char * filename, uint32_t journalSize)
+{
+  memcpy(&savedModel, model, sizeof(savedModel));
+  strncpy(savedModelFilename, filename, LEN_MODEL_FILENAME);
+  savedModelFilename[LEN_MODEL_FILENAME] = '\0';
+  modelJournalSize = journalSize;
+}
+
+static const char * writeModelFile(const char * filename)
+{
+  char path[256];
+  getModelPath(path, filename);
+  memcpy(&modelSnapshot, &g_model, sizeof(modelSnapshot));
+  const char * error = writeFile(path, (uint8_t *)&modelSnapshot, sizeof(modelSnapshot));
+  if (error) {
+    savedModelFilename[0] = '\0';
+    modelJournalSize = 0;
+    return error;
+  }
+
+  // the journal changes are now in the model file
+  getModelJournalPath(path, filename);
+  f_unlink(path);
+  setSavedModel(&modelSnapshot, filename, 0);
+  return NULL;
+}
+
 const char * writeModel()
 {
+  return writeModelFile(g_eeGeneral.currModelFilename);
+}
+
+// returns the end of the next changed range starting at or after *offset
+static uint32_t findModelChanges(uint32_t * offset)
+{
+  const uint8_t * current = (const uint8_t *)&modelSnapshot;
+  const uint8_t * saved = (const uint8_t *)&savedModel;
+
+  uint32_t start = *offset;
+  while (start < sizeof(g_model) && current[start] == saved[start]) {
+    start++;
+  }
+
+  uint32_t end = start;
+  for (uint32_t i=start; i<sizeof(g_model) && i<=end+MODEL_JOURNAL_MERGE_GAP; i++) {
+    if (current[i] != saved[i]) {
+      end = i + 1;
+    }
+  }
+
+  *offset = start;
+  return end;
+}
+
+static const char * writeModelJournal()
+{
+  const char * filename = g_eeGeneral.currModelFilename;
+
+  if (strncmp(savedModelFilename, filename, LEN_MODEL_FILENAME)) {
+    return writeModelFile(filename);
+  }
+
+  memcpy(&modelSnapshot, &g_model, sizeof(modelSnapshot));
+
+  uint32_t recordsSize = 0;
+  for (uint32_t offset=0, end; (end = findModelChanges(&offset)) > offset; offset=end) {
+    recordsSize += sizeof(ModelJournalRecord) + (end - offset) + sizeof(uint16_t);
+  }
+
+  if (recordsSize == 0) {
+    return NULL;
+  }
+  else if ((modelJournalSize ? modelJournalSize : sizeof(ModelJournalHeader)) + recordsSize > MODEL_JOURNAL_MAX_SIZE) {
+    TRACE("model journal compaction");
+    return writeModelFile(filename);
+  }
+
   char path[256];
-  getModelPath(path, g_eeGeneral.currModelFilename);
-  return writeFile(path, (uint8_t *)&g_model, sizeof(g_model));
+  getModelJournalPath(path, filename);
+
+  FIL file;
+  UINT written;
+  FRESULT result = f_open(&file, path, (modelJournalSize ? FA_OPEN_EXISTING : FA_CREATE_ALWAYS) | FA_WRITE);
+  if (result != FR_OK) {
+    TRACE("model journal error=%d", result);
+    return writeModelFile(filename);
+  }
+
+  if (modelJournalSize == 0) {
+    ModelJournalHeader header;
+    memcpy(header.magic, MODEL_JOURNAL_MAGIC, sizeof(header.magic));
+    header.modelSize = sizeof(savedModel);
+    header.modelCrc = crc16(CRC_1021, (const uint8_t *)&savedModel, sizeof(savedModel));
+    result = f_write(&file, &header, sizeof(header), &written);
+    if (result == FR_OK && written != sizeof(header)) {
+      result = FR_DISK_ERR;
+    }
+  }
+  else {
+    result = f_lseek(&file, modelJournalSize);
+  }
+
+  for (uint32_t offset=0, end; result == FR_OK && (end = findModelChanges(&offset)) > offset; offset=end) {
+    ModelJournalRecord record;
+    record.offset = offset;
+    record.size = end - offset;
+    const uint8_t * data = (const uint8_t *)&modelSnapshot + offset;
+    uint16_t crc = crc16(CRC_1021, data, record.size, crc16(CRC_1021, (const uint8_t *)&record, sizeof(record)));
+    UINT size = 0;
+    result = f_write(&file, &record, sizeof(record), &written);
+    size += written;
+    if (result == FR_OK) {
+      result = f_write(&file, data, record.size, &written);
+      size += written;
+    }
+    if (result == FR_OK) {
+      result = f_write(&file, &crc, sizeof(crc), &written);
+      size += written;
+    }
+    if (result == FR_OK && size != sizeof(record) + record.size + sizeof(crc)) {
+      result = FR_DISK_ERR;
+    }
+  }
+
+  uint32_t journalSize = f_tell(&file);
+  if (result == FR_OK) {
+    // anything after the last record we wrote is dropped
+    result = f_truncate(&file);
+  }
+
+  FRESULT closeResult = f_close(&file);
+  if (result == FR_OK) {
+    result = closeResult;
+  }
+
+  if (result != FR_OK) {
+    TRACE("model journal error=%d", result);
+    return writeModelFile(filename);
+  }
+
+  setSavedModel(&modelSnapshot, filename, journalSize);
+  return NULL;
 }
 
-const char * loadFile(const char * filename, uint8_t * data, uint16_t maxsize)
+// applies the journal of the model to g_model, returns true if there was one
+static bool replayModelJournal(const char * filename)
 {
-  TRACE("loadFile(%s)", filename);
-  
+  char path[256];
+  getModelJournalPath(path, filename);
+
   FIL file;
+  if (f_open(&file, path, FA_OPEN_EXISTING | FA_READ) != FR_OK) {
+    return false;
+  }
+
+  ModelJournalHeader header;
+  UINT read;
+  FRESULT result = f_read(&file, &header, sizeof(header), &read);
+  if (result == FR_OK && read == sizeof(header) && !memcmp(header.magic, MODEL_JOURNAL_MAGIC, sizeof(header.magic)) &&
+      header.modelSize == sizeof(g_model) && header.modelCrc == crc16(CRC_1021, (const uint8_t *)&g_model, sizeof(g_model))) {
+    // the records are checked in savedModel before being applied, the replay stops on
+    // the first invalid one (i.e. the last one if the radio was turned off while writing it)
+    memcpy(&savedModel, &g_model, sizeof(g_model));
+    ModelJournalRecord record;
+    while (f_read(&file, &record, sizeof(record), &read) == FR_OK && read == sizeof(record)) {
+      if (record.size == 0 || record.offset + record.size > sizeof(g_model)) {
+        break;
+      }
+      uint8_t * data = (uint8_t *)&savedModel + record.offset;
+      uint16_t crc;
+      if (f_read(&file, data, record.size, &read) != FR_OK || read != record.size ||
+          f_read(&file, &crc, sizeof(crc), &read) != FR_OK || read != sizeof(crc) ||
+          crc != crc16(CRC_1021, data, record.size, crc16(CRC_1021, (const uint8_t *)&record, sizeof(record)))) {
+        break;
+      }
+      memcpy((uint8_t *)&g_model + record.offset, data, record.size);
+    }
+  }
+  else {
+    TRACE("model journal %s discarded", path);
+  }
+
+  f_close(&file);
+  return true;
+}
+
+const char * openFile(const char * fullpath, FIL * file, uint16_t * size)
+{
   char buf[8];
   UINT read;
 
-  FRESULT result = f_open(&file, filename, FA_OPEN_EXISTING | FA_READ);
+  FRESULT result = f_open(file, fullpath, FA_OPEN_EXISTING | FA_READ);
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
 
-  if (f_size(&file) < 8) {
-    f_close(&file);
+  if (f_size(file) < 8) {
+    f_close(file);
     return STR_INCOMPATIBLE;
   }
 
-  result = f_read(&file, (uint8_t *)buf, 8, &read);
+  result = f_read(file, (uint8_t *)buf, 8, &read);
   if (result != FR_OK || read != 8) {
-    f_close(&file);
+    f_close(file);
     return SDCARD_ERROR(result);
   }
 
   uint8_t version = (uint8_t)buf[4];
   if ((*(uint32_t*)&buf[0] != OTX_FOURCC && *(uint32_t*)&buf[0] != O9X_FOURCC) || version < FIRST_CONV_EEPROM_VER || version > EEPROM_VER || buf[5] != 'M') {
-    f_close(&file);
+    f_close(file);
     return STR_INCOMPATIBLE;
   }
 
-  uint16_t size = min<uint16_t>(maxsize, *(uint16_t*)&buf[6]);
-  result = f_read(&file, data, size, &read);
+  *size = *(uint16_t*)&buf[6];
+  return NULL;
+}
+
+const char * loadFile(const char * filename, uint8_t * data, uint16_t maxsize)
+{
+  TRACE("loadFile(%s)", filename);
+  
+  FIL file;
+  UINT read;
+  uint16_t size;
+
+  const char * error = openFile(filename, &file, &size);
+  if (error) {
+    return error;
+  }
+
+  size = min<uint16_t>(maxsize, size);
+  FRESULT result = f_read(&file, data, size, &read);
   if (result != FR_OK || read != size) {
     f_close(&file);
     return SDCARD_ERROR(result);
@@ -116,11 +354,28 @@ const char * readModel(const char * filename, uint8_t * buffer, uint32_t size)
   return loadFile(path, buffer, size);
 }
 
+const char * loadModelFile(const char * filename)
+{
+  const char * error = readModel(filename, (uint8_t *)&g_model, sizeof(g_model));
+  if (error) {
+    return error;
+  }
+
+  if (replayModelJournal(filename)) {
+    writeModelFile(filename);
+  }
+  else {
+    setSavedModel(&g_model, filename, 0);
+  }
+
+  return NULL;
+}
+
 const char * loadModel(const char * filename, bool alarms)
 {
   preModelLoad();
 
-  const char * error = readModel(filename, (uint8_t *)&g_model, sizeof(g_model));
+  const char * error = loadModelFile(filename);
   if (error) {
     TRACE("loadModel error=%s", error);
   }
@@ -165,6 +420,13 @@ void storageCheck(bool immediately)
   if (storageDirtyMsk & EE_MODEL) {
     TRACE("eeprom write model");
     storageDirtyMsk -= EE_MODEL;
+    const char * error = (immediately ? writeModel() : writeModelJournal());
+    if (error) {
+      TRACE("writeModel error=%s", error);
+    }
+  }
+  else if (immediately && modelJournalSize > 0 && !strncmp(savedModelFilename, g_eeGeneral.currModelFilename, LEN_MODEL_FILENAME)) {
+    TRACE("eeprom compact model journal");
     const char * error = writeModel();
     if (error) {
       TRACE("writeModel error=%s", error);
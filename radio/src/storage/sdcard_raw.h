@@ -32,6 +32,8 @@ const char * openFile(const char * fullpath, FIL* file, uint16_t* size);
 void getModelPath(char * path, const char * filename);
 
 const char * readModel(const char * filename, uint8_t * buffer, uint32_t size);
+// reads the model file in g_model and applies its journal, without the pre / post model load steps
+const char * loadModelFile(const char * filename);
 const char * loadModel(const char * filename, bool alarms=true);
 const char * createModel();
 
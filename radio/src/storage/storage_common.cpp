@@ -34,6 +34,17 @@ void storageDirty(uint8_t msk)
   storageDirtyMsk |= msk;
   storageDirtyTime10ms = get_tmr10ms();
 
+  if (msk & EE_MODEL) {
+    MIX_PLAN_INVALIDATE();
+    LS_PLAN_INVALIDATE();
+#if defined(CPUARM)
+    invalidateTelemetrySensorsIndex();
+#endif
+#if defined(CPUARM) && defined(CURVES)
+    invalidateCurveTangents();
+#endif
+  }
+
 #if defined(RAMBACKUP)
   rambackupDirtyMsk = storageDirtyMsk;
   rambackupDirtyTime10ms = storageDirtyTime10ms;
@@ -128,6 +139,11 @@ if (!isExternalModuleAvailable(g_model.moduleData[EXTERNAL_MODULE].type)) {
 #endif
 
   LOAD_MODEL_CURVES();
+  MIX_PLAN_INVALIDATE();
+  LS_PLAN_INVALIDATE();
+#if defined(CPUARM)
+  invalidateTelemetrySensorsIndex();
+#endif
 
   resumeMixerCalculations();
   if (pulsesStarted()) {
@@ -577,24 +577,116 @@ bool getSwitch(swsrc_t swtch)
 }
 
 #if defined(CPUARM)
+#if MAX_LOGICAL_SWITCHES > 64
+  #error "bitfield_logical_switches_t is too small"
+#endif
+
+LogicalSwitchesPlan lsPlan;
+bool lsPlanDirty = true;
+uint16_t lsPlanEvaluated = 0; // flight modes evaluated since the plan was compiled
+
+static bitfield_logical_switches_t lswInputMask(swsrc_t swtch)
+{
+  uint8_t cs_idx = abs(swtch);
+  if (cs_idx >= SWSRC_FIRST_LOGICAL_SWITCH && cs_idx <= SWSRC_LAST_LOGICAL_SWITCH)
+    return (bitfield_logical_switches_t)1 << (cs_idx - SWSRC_FIRST_LOGICAL_SWITCH);
+  else
+    return 0;
+}
+
+void compileLogicalSwitchesPlan()
+{
+  lsPlanDirty = false;
+  lsPlanEvaluated = 0;
+
+  bitfield_logical_switches_t remaining = 0;
+  bitfield_logical_switches_t candidates = 0;
+
+  for (uint8_t idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+    LogicalSwitchData * ls = lswAddress(idx);
+    bitfield_logical_switches_t mask = (bitfield_logical_switches_t)1 << idx;
+    lsPlan.inputs[idx] = 0;
+    if (ls->func == LS_FUNC_NONE) {
+      // unused switches are not evaluated anymore, they are left OFF
+      for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
+        LogicalSwitchContext & context = lswFm[fm].lsw[idx];
+        context.state = 0;
+        context.timerState = SWITCH_START;
+        context.timer = 0;
+        context.lastValue = CS_LAST_VALUE_INIT;
+      }
+      continue;
+    }
+    remaining |= mask;
+    lsPlan.inputs[idx] = lswInputMask(ls->andsw);
+    if (lswFamily(ls->func) == LS_FAMILY_BOOL) {
+      lsPlan.inputs[idx] |= lswInputMask(ls->v1) | lswInputMask(ls->v2);
+      // a boolean switch without timers only reading logical switches keeps its state while they don't change
+      if (!ls->delay && !ls->duration &&
+          (!ls->andsw || lswInputMask(ls->andsw)) && (!ls->v1 || lswInputMask(ls->v1)) && (!ls->v2 || lswInputMask(ls->v2))) {
+        candidates |= mask;
+      }
+    }
+  }
+
+  // topological order, the lowest index first when several switches are ready
+  lsPlan.count = 0;
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (uint8_t idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+      bitfield_logical_switches_t mask = (bitfield_logical_switches_t)1 << idx;
+      if ((remaining & mask) && !(lsPlan.inputs[idx] & remaining)) {
+        lsPlan.order[lsPlan.count++] = idx;
+        remaining &= ~mask;
+        progress = true;
+      }
+    }
+  }
+
+  // switches in a loop (and the ones depending on them) are evaluated last, in index order,
+  // they read the previous state of the switches evaluated after them
+  lsPlan.derived = candidates & ~remaining;
+  for (uint8_t idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+    if (remaining & ((bitfield_logical_switches_t)1 << idx)) {
+      lsPlan.order[lsPlan.count++] = idx;
+    }
+  }
+}
+
 /**
   @brief Calculates new state of logical switches for mixerCurrentFlightMode
 */
 void evalLogicalSwitches(bool isCurrentPhase)
 {
-  for (unsigned int idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+  if (lsPlanDirty) {
+    compileLogicalSwitchesPlan();
+  }
+
+  bool evaluated = lsPlanEvaluated & (1 << mixerCurrentFlightMode);
+  bitfield_logical_switches_t changed = 0;
+
+  for (uint8_t i=0; i<lsPlan.count; i++) {
+    uint8_t idx = lsPlan.order[i];
+    bitfield_logical_switches_t mask = (bitfield_logical_switches_t)1 << idx;
+    if (evaluated && (lsPlan.derived & mask) && !(lsPlan.inputs[idx] & changed)) {
+      continue;
+    }
     LogicalSwitchContext & context = lswFm[mixerCurrentFlightMode].lsw[idx];
     bool result = getLogicalSwitch(idx);
-    if (isCurrentPhase) {
-      if (result) {
-        if (!context.state) PLAY_LOGICAL_SWITCH_ON(idx);
-      }
-      else {
-        if (context.state) PLAY_LOGICAL_SWITCH_OFF(idx);
+    if (result != context.state) {
+      changed |= mask;
+      if (isCurrentPhase) {
+        if (result)
+          PLAY_LOGICAL_SWITCH_ON(idx);
+        else
+          PLAY_LOGICAL_SWITCH_OFF(idx);
       }
     }
     context.state = result;
   }
+
+  lsPlanEvaluated |= (1 << mixerCurrentFlightMode);
 }
 #endif
 
@@ -991,6 +1083,7 @@ void logicalSwitchesReset()
 #if defined(CPUARM)
   flightModeTransitionLast = 255;
   memset(lswFm, 0, sizeof(lswFm));
+  lsPlanEvaluated = 0;
 #else
   s_last_switch_value = 0;
 #endif
@@ -1024,5 +1117,6 @@ getvalue_t convertLswTelemValue(LogicalSwitchData * ls)
 void logicalSwitchesCopyState(uint8_t src, uint8_t dst)
 {
   lswFm[dst] = lswFm[src];
+  lsPlanEvaluated &= ~(1 << dst);
 }
 #endif
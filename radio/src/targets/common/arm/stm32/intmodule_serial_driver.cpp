@@ -102,6 +102,9 @@ void intmoduleSerialStart(uint32_t baudrate, uint8_t rxEnable, uint16_t parity,
   USART_Cmd(INTMODULE_USART, ENABLE);
   USART_ITConfig(INTMODULE_USART, USART_IT_RXNE, ENABLE);
   USART_ITConfig(INTMODULE_USART, USART_IT_TXE, DISABLE);
+#if defined(TELEMETRY_RX_EVENTS)
+  USART_ITConfig(INTMODULE_USART, USART_IT_IDLE, ENABLE);
+#endif
   NVIC_SetPriority(INTMODULE_USART_IRQn, 7);
   NVIC_EnableIRQ(INTMODULE_USART_IRQn);
 #else // RX by DMA
@@ -133,6 +136,12 @@ void intmoduleSerialStart(uint32_t baudrate, uint8_t rxEnable, uint16_t parity,
   USART_ITConfig(INTMODULE_USART, USART_IT_TXE, DISABLE);
   USART_Cmd(INTMODULE_USART, ENABLE);
   DMA_Cmd(INTMODULE_RX_DMA_STREAM, ENABLE); // TRACE("RF DMA receive started...");
+#if defined(TELEMETRY_RX_EVENTS)
+  // the bytes are received by DMA, only the idle line interrupt is used
+  USART_ITConfig(INTMODULE_USART, USART_IT_IDLE, ENABLE);
+  NVIC_SetPriority(INTMODULE_USART_IRQn, 7);
+  NVIC_EnableIRQ(INTMODULE_USART_IRQn);
+#endif
  #endif
   intmodule_hal_inited = 1;
 }
@@ -147,13 +156,37 @@ extern "C" void INTMODULE_USART_IRQHandler(void)
 
   // Receive
   uint32_t status = INTMODULE_USART->SR;
+#if defined(TELEMETRY_RX_EVENTS) && !defined(INTMODULE_RX_INT)
+  // the bytes are received by DMA, the idle flag is cleared by a read of DR after SR, unless the DMA will read the pending byte
+  if (status & USART_FLAG_IDLE) {
+    if (!(status & USART_FLAG_RXNE)) {
+      (void)INTMODULE_USART->DR;
+    }
+    telemetryReceiveEvent(INTERNAL_MODULE);
+  }
+#else
+#if defined(TELEMETRY_RX_EVENTS)
+  uint32_t events = status;
+#endif
   while (status & (USART_FLAG_RXNE | USART_FLAG_ERRORS)) {
     uint8_t data = INTMODULE_USART->DR;
     if (!(status & USART_FLAG_ERRORS)) {
       intmoduleRxFifo.push(data);
     }
     status = INTMODULE_USART->SR;
+#if defined(TELEMETRY_RX_EVENTS)
+    events |= status;
+#endif
   }
+#if defined(TELEMETRY_RX_EVENTS)
+  if (events & USART_FLAG_IDLE) {
+    if (status & USART_FLAG_IDLE) {
+      (void)INTMODULE_USART->DR;
+    }
+    telemetryReceiveEvent(INTERNAL_MODULE);
+  }
+#endif
+#endif
 }
 
 extern "C" void INTMODULE_TX_DMA_Stream_IRQHandler(void)
@@ -177,18 +210,39 @@ uint8_t intmoduleGetByte(uint8_t * byte)
 #endif
 }
 
+// Contiguous block of received bytes, they stay in the fifo until intmoduleSkipData() is called
+uint32_t intmoduleGetData(const uint8_t ** data)
+{
+    if (intmodule_hal_inited == 0) {
+        return 0;
+    }
+#ifdef INTMODULE_RX_INT
+    return intmoduleRxFifo.getContiguousData(*data);
+#else
+    return intmoduleDMAFifo.getContiguousData(*data);
+#endif
+}
+
+void intmoduleSkipData(uint32_t count)
+{
+#ifdef INTMODULE_RX_INT
+    intmoduleRxFifo.skip(count);
+#else
+    intmoduleDMAFifo.skip(count);
+#endif
+}
+
 static uint8_t dmaBuffer[512] __DMA;
 
-void intmoduleSendBufferDMA(uint8_t * data, uint16_t size)
+// the data must stay untouched (and be DMA accessible) until the end of the transfer
+static void intmoduleStartBufferDMA(const uint8_t * data, uint16_t size)
 {
-  if (size ==0 || size > 512) return;
-  memcpy(dmaBuffer, data, size);
   DMA_InitTypeDef DMA_InitStructure;
   DMA_DeInit(INTMODULE_TX_DMA_STREAM);
   DMA_InitStructure.DMA_Channel = INTMODULE_DMA_CHANNEL;
   DMA_InitStructure.DMA_PeripheralBaseAddr = CONVERT_PTR_UINT(&INTMODULE_USART->DR);
   DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
-  DMA_InitStructure.DMA_Memory0BaseAddr = CONVERT_PTR_UINT(dmaBuffer);
+  DMA_InitStructure.DMA_Memory0BaseAddr = CONVERT_PTR_UINT(data);
   DMA_InitStructure.DMA_BufferSize = size;
   DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
   DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
@@ -205,6 +259,13 @@ void intmoduleSendBufferDMA(uint8_t * data, uint16_t size)
   USART_DMACmd(INTMODULE_USART, USART_DMAReq_Tx, ENABLE);
 }
 
+void intmoduleSendBufferDMA(uint8_t * data, uint16_t size)
+{
+  if (size ==0 || size > 512) return;
+  memcpy(dmaBuffer, data, size);
+  intmoduleStartBufferDMA(dmaBuffer, size);
+}
+
 
 void intmoduleSendNextFrame()
 {
@@ -213,9 +274,11 @@ void intmoduleSendNextFrame()
   switch(moduleState[INTERNAL_MODULE].protocol) {
 #if defined(AFHDS2)
     case PROTOCOL_CHANNELS_AFHDS2:
-      data = (uint8_t*)intmodulePulsesData.flysky.pulses;
-      size = intmodulePulsesData.flysky.ptr - data;
-      break;
+      // double buffered, sent without copy
+      if (intmodulePulsesData.flysky.getSize() > 0) {
+        intmoduleStartBufferDMA(intmodulePulsesData.flysky.getData(), intmodulePulsesData.flysky.getSize());
+      }
+      return;
 #endif
 
 #if defined(PXX1)
@@ -452,6 +452,17 @@ void DMAFillRect(uint16_t * dest, uint16_t destw, uint16_t desth, uint16_t x, ui
 void DMACopyBitmap(uint16_t * dest, uint16_t destw, uint16_t desth, uint16_t x, uint16_t y, const uint16_t * src, uint16_t srcw, uint16_t srch, uint16_t srcx, uint16_t srcy, uint16_t w, uint16_t h);
 void DMACopyAlphaBitmap(uint16_t * dest, uint16_t destw, uint16_t desth, uint16_t x, uint16_t y, const uint16_t * src, uint16_t srcw, uint16_t srch, uint16_t srcx, uint16_t srcy, uint16_t w, uint16_t h);
 void DMABitmapConvert(uint16_t * dest, const uint8_t * src, uint16_t w, uint16_t h, uint32_t format);
+#if defined(SIMU)
+#define DMAWait()
+#else
+// The DMA operations above are queued, this waits until they are all done
+extern volatile uint8_t dmaPendingOperations;
+inline void DMAWait()
+{
+  while (dmaPendingOperations > 0)
+    ;
+}
+#endif
 void lcdSetContrast();
 void lcdOff();
 void lcdOn();
@@ -523,13 +534,18 @@ int32_t getVolume(void);
 
 // Telemetry driver
 #define TELEMETRY_FIFO_SIZE             512
+#define TELEMETRY_RX_EVENTS                     // the receive interrupts wake up the telemetry task at the end of each frame
 void telemetryPortInit(uint32_t baudrate, uint8_t mode);
 void telemetryPortSetDirectionOutput(void);
 void telemetryPortSetDirectionInput(void);
 void sportSendBuffer(uint8_t * buffer, uint32_t count);
 void sportSendByte(uint8_t byte);
 uint8_t telemetryGetByte(uint8_t * byte);
+uint32_t telemetryGetData(const uint8_t ** data);
+void telemetrySkipData(uint32_t count);
 uint8_t heartbeatTelemetryGetByte(uint8_t * byte);
+uint32_t heartbeatTelemetryGetData(const uint8_t ** data);
+void heartbeatTelemetrySkipData(uint32_t count);
 extern uint32_t telemetryErrors;
 
 // Haptic driver
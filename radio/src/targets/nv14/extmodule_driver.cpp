@@ -67,6 +67,9 @@ void extmoduleStop()
   NVIC_DisableIRQ(EXTMODULE_DMA_IRQn);
   NVIC_DisableIRQ(EXTMODULE_TIMER_IRQn);
   NVIC_DisableIRQ(EXTMODULE_USART_TX_DMA_IRQn);
+#if defined(TELEMETRY_RX_EVENTS)
+  NVIC_DisableIRQ(EXTMODULE_USART_IRQn);
+#endif
 
   USART_DeInit(EXTMODULE_USART);
 
@@ -289,6 +292,13 @@ void extmoduleSerialStart(uint32_t baudRate, bool inverted, uint16_t wordLength,
 
   NVIC_EnableIRQ(EXTMODULE_USART_TX_DMA_IRQn);
   NVIC_SetPriority(EXTMODULE_USART_TX_DMA_IRQn, 7);
+
+#if defined(TELEMETRY_RX_EVENTS)
+  // the bytes are received by DMA, only the idle line interrupt is used
+  USART_ITConfig(EXTMODULE_USART, USART_IT_IDLE, ENABLE);
+  NVIC_SetPriority(EXTMODULE_USART_IRQn, 7);
+  NVIC_EnableIRQ(EXTMODULE_USART_IRQn);
+#endif
 }
 
 #if defined(PXX1)
@@ -467,7 +477,7 @@ void extmoduleSendNextFrame()
 #endif
 #if defined(AFHDS3)
   else if (moduleState[EXTERNAL_MODULE].protocol == PROTOCOL_CHANNELS_AFHDS3) {
-    extmoduleSendBuffer(extmodulePulsesData.flysky.pulses, extmodulePulsesData.flysky.ptr - extmodulePulsesData.flysky.pulses);
+    extmoduleSendBuffer(extmodulePulsesData.flysky.getData(), extmodulePulsesData.flysky.getSize());
   }
 #endif
   else {
@@ -537,6 +547,20 @@ extern "C" void EXTMODULE_USART_TX_DMA_IRQHandler(void)
   }
 }
 
+#if defined(TELEMETRY_RX_EVENTS)
+extern "C" void EXTMODULE_USART_IRQHandler(void)
+{
+  // the idle flag is cleared by a read of DR after SR, unless the DMA will read the pending byte
+  uint32_t status = EXTMODULE_USART->SR;
+  if (status & USART_FLAG_IDLE) {
+    if (!(status & USART_FLAG_RXNE)) {
+      (void)EXTMODULE_USART->DR;
+    }
+    telemetryReceiveEvent(EXTERNAL_MODULE);
+  }
+}
+#endif
+
 extern "C" void EXTMODULE_DMA_IRQHandler()
 {
   bool startTimer = false;
@@ -581,3 +605,13 @@ uint8_t heartbeatTelemetryGetByte(uint8_t * byte)
   return extTelemetryDMAFifo.pop(*byte);
 }
 
+uint32_t heartbeatTelemetryGetData(const uint8_t ** data)
+{
+  return extTelemetryDMAFifo.getContiguousData(*data);
+}
+
+void heartbeatTelemetrySkipData(uint32_t count)
+{
+  extTelemetryDMAFifo.skip(count);
+}
+
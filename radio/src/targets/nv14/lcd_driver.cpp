@@ -1114,6 +1114,88 @@ void LCD_SetTransparency(uint8_t transparency)
   LTDC_ReloadConfig(LTDC_IMReload);
 }
 
+// The DMA2D operations are queued, the transfer complete interrupt starts the
+// next one. The CPU only waits for them (DMAWait) before accessing the pixels
+// itself, or before showing the layer
+struct DMAOperation {
+  uint32_t mode;
+  uint32_t outputColorMode;
+  uint32_t outputColor;
+  uint32_t outputAddress;
+  uint32_t outputOffset;
+  uint32_t size;
+  uint32_t foregroundAddress;
+  uint32_t foregroundOffset;
+  uint32_t foregroundColorMode;
+  uint32_t backgroundAddress;
+  uint32_t backgroundOffset;
+  uint32_t backgroundColorMode;
+};
+
+#define DMA_QUEUE_SIZE                 16
+
+static DMAOperation dmaQueue[DMA_QUEUE_SIZE];
+static uint8_t dmaQueueHead = 0; // the operation in progress
+static uint8_t dmaQueueTail = 0; // the next free slot
+volatile uint8_t dmaPendingOperations = 0;
+
+static void DMAInit()
+{
+  NVIC_InitTypeDef NVIC_InitStructure;
+  NVIC_InitStructure.NVIC_IRQChannel = DMA2D_IRQn;
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = DMA_SCREEN_IRQ_PRIO;
+  NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+  NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+  NVIC_Init(&NVIC_InitStructure);
+}
+
+static void DMAStart(const DMAOperation * op)
+{
+  DMA2D->CR = op->mode | DMA2D_CR_TCIE;
+  DMA2D->OPFCCR = op->outputColorMode;
+  DMA2D->OCOLR = op->outputColor;
+  DMA2D->OMAR = op->outputAddress;
+  DMA2D->OOR = op->outputOffset;
+  DMA2D->NLR = op->size;
+  DMA2D->FGMAR = op->foregroundAddress;
+  DMA2D->FGOR = op->foregroundOffset;
+  DMA2D->FGPFCCR = op->foregroundColorMode;
+  DMA2D->BGMAR = op->backgroundAddress;
+  DMA2D->BGOR = op->backgroundOffset;
+  DMA2D->BGPFCCR = op->backgroundColorMode;
+  DMA2D->CR |= DMA2D_CR_START;
+}
+
+static DMAOperation * DMAAllocate()
+{
+  // the queue is full, wait for the oldest operation to be done
+  while (dmaPendingOperations >= DMA_QUEUE_SIZE)
+    ;
+
+  DMAOperation * op = &dmaQueue[dmaQueueTail];
+  memclear(op, sizeof(DMAOperation));
+  return op;
+}
+
+static void DMAPush()
+{
+  __disable_irq();
+  dmaQueueTail = (dmaQueueTail + 1) % DMA_QUEUE_SIZE;
+  if (dmaPendingOperations++ == 0) {
+    DMAStart(&dmaQueue[dmaQueueHead]);
+  }
+  __enable_irq();
+}
+
+extern "C" void DMA2D_IRQHandler()
+{
+  DMA2D->IFCR = DMA2D_IFSR_CTCIF;
+  dmaQueueHead = (dmaQueueHead + 1) % DMA_QUEUE_SIZE;
+  if (--dmaPendingOperations > 0) {
+    DMAStart(&dmaQueue[dmaQueueHead]);
+  }
+}
+
 void lcdInit(void)
 {
   /* Configure the LCD SPI+RESET pins */
@@ -1149,6 +1231,7 @@ void lcdInit(void)
     detectedLCD->LCD_Init();
 
   LCD_Init_LTDC(detectedLCD->DotClock);
+  DMAInit();
 
   LCD_LayerInit();
 
@@ -1171,179 +1254,77 @@ void lcdInit(void)
 void DMAFillRect(uint16_t *dest, uint16_t destw, uint16_t desth, uint16_t x,
                  uint16_t y, uint16_t w, uint16_t h, uint16_t color)
 {
-  DMA2D_DeInit();
-
-  DMA2D_InitTypeDef DMA2D_InitStruct;
-  DMA2D_InitStruct.DMA2D_Mode = DMA2D_R2M;
-  DMA2D_InitStruct.DMA2D_CMode = DMA2D_RGB565;
-  DMA2D_InitStruct.DMA2D_OutputGreen = (0x07E0 & color) >> 5;
-  DMA2D_InitStruct.DMA2D_OutputBlue = 0x001F & color;
-  DMA2D_InitStruct.DMA2D_OutputRed = (0xF800 & color) >> 11;
-  DMA2D_InitStruct.DMA2D_OutputAlpha = 0x0F;
-  DMA2D_InitStruct.DMA2D_OutputMemoryAdd = CONVERT_PTR_UINT(dest) + 2 * (destw * y + x);
-  DMA2D_InitStruct.DMA2D_OutputOffset = (destw - w);
-  DMA2D_InitStruct.DMA2D_NumberOfLine = h;
-  DMA2D_InitStruct.DMA2D_PixelPerLine = w;
-  DMA2D_Init(&DMA2D_InitStruct);
-
-  /* Start Transfer */
-  DMA2D_StartTransfer();
-
-  /* Wait for CTC Flag activation */
-  while (DMA2D_GetFlagStatus(DMA2D_FLAG_TC) == RESET)
-    ;
+  DMAOperation * op = DMAAllocate();
+  op->mode = DMA2D_R2M;
+  op->outputColorMode = DMA2D_RGB565;
+  op->outputColor = color;
+  op->outputAddress = CONVERT_PTR_UINT(dest + y * destw + x);
+  op->outputOffset = destw - w;
+  op->size = (w << 16) | h;
+  DMAPush();
 }
 
 void DMACopyBitmap(uint16_t *dest, uint16_t destw, uint16_t desth, uint16_t x,
                    uint16_t y, const uint16_t *src, uint16_t srcw, uint16_t srch,
                    uint16_t srcx, uint16_t srcy, uint16_t w, uint16_t h)
 {
-  DMA2D_DeInit();
-
-  DMA2D_InitTypeDef DMA2D_InitStruct;
-  DMA2D_InitStruct.DMA2D_Mode = DMA2D_M2M;
-  DMA2D_InitStruct.DMA2D_CMode = DMA2D_RGB565;
-  DMA2D_InitStruct.DMA2D_OutputMemoryAdd = CONVERT_PTR_UINT(
-      dest + y * destw + x);
-  DMA2D_InitStruct.DMA2D_OutputGreen = 0;
-  DMA2D_InitStruct.DMA2D_OutputBlue = 0;
-  DMA2D_InitStruct.DMA2D_OutputRed = 0;
-  DMA2D_InitStruct.DMA2D_OutputAlpha = 0;
-  DMA2D_InitStruct.DMA2D_OutputOffset = destw - w;
-  DMA2D_InitStruct.DMA2D_NumberOfLine = h;
-  DMA2D_InitStruct.DMA2D_PixelPerLine = w;
-  DMA2D_Init(&DMA2D_InitStruct);
-
-  DMA2D_FG_InitTypeDef DMA2D_FG_InitStruct;
-  DMA2D_FG_StructInit(&DMA2D_FG_InitStruct);
-  DMA2D_FG_InitStruct.DMA2D_FGMA = CONVERT_PTR_UINT(src + srcy * srcw + srcx);
-  DMA2D_FG_InitStruct.DMA2D_FGO = srcw - w;
-  DMA2D_FG_InitStruct.DMA2D_FGCM = CM_RGB565;
-  DMA2D_FG_InitStruct.DMA2D_FGPFC_ALPHA_MODE = NO_MODIF_ALPHA_VALUE;
-  DMA2D_FG_InitStruct.DMA2D_FGPFC_ALPHA_VALUE = 0;
-  DMA2D_FGConfig(&DMA2D_FG_InitStruct);
-
-  /* Start Transfer */
-  DMA2D_StartTransfer();
-
-  /* Wait for CTC Flag activation */
-  while (DMA2D_GetFlagStatus(DMA2D_FLAG_TC) == RESET)
-    ;
+  DMAOperation * op = DMAAllocate();
+  op->mode = DMA2D_M2M;
+  op->outputColorMode = DMA2D_RGB565;
+  op->outputAddress = CONVERT_PTR_UINT(dest + y * destw + x);
+  op->outputOffset = destw - w;
+  op->size = (w << 16) | h;
+  op->foregroundAddress = CONVERT_PTR_UINT(src + srcy * srcw + srcx);
+  op->foregroundOffset = srcw - w;
+  op->foregroundColorMode = CM_RGB565;
+  DMAPush();
 }
 
 void DMACopyAlphaBitmap(uint16_t *dest, uint16_t destw, uint16_t desth,
                         uint16_t x, uint16_t y, const uint16_t *src, uint16_t srcw, uint16_t srch,
                         uint16_t srcx, uint16_t srcy, uint16_t w, uint16_t h)
 {
-  DMA2D_DeInit();
-
-  DMA2D_InitTypeDef DMA2D_InitStruct;
-  DMA2D_InitStruct.DMA2D_Mode = DMA2D_M2M_BLEND;
-  DMA2D_InitStruct.DMA2D_CMode = DMA2D_RGB565;
-  DMA2D_InitStruct.DMA2D_OutputMemoryAdd = CONVERT_PTR_UINT(
-      dest + y * destw + x);
-  DMA2D_InitStruct.DMA2D_OutputGreen = 0;
-  DMA2D_InitStruct.DMA2D_OutputBlue = 0;
-  DMA2D_InitStruct.DMA2D_OutputRed = 0;
-  DMA2D_InitStruct.DMA2D_OutputAlpha = 0;
-  DMA2D_InitStruct.DMA2D_OutputOffset = destw - w;
-  DMA2D_InitStruct.DMA2D_NumberOfLine = h;
-  DMA2D_InitStruct.DMA2D_PixelPerLine = w;
-  DMA2D_Init(&DMA2D_InitStruct);
-
-  DMA2D_FG_InitTypeDef DMA2D_FG_InitStruct;
-  DMA2D_FG_StructInit(&DMA2D_FG_InitStruct);
-  DMA2D_FG_InitStruct.DMA2D_FGMA = CONVERT_PTR_UINT(src + srcy * srcw + srcx);
-  DMA2D_FG_InitStruct.DMA2D_FGO = srcw - w;
-  DMA2D_FG_InitStruct.DMA2D_FGCM = CM_ARGB4444;
-  DMA2D_FG_InitStruct.DMA2D_FGPFC_ALPHA_MODE = NO_MODIF_ALPHA_VALUE;
-  DMA2D_FG_InitStruct.DMA2D_FGPFC_ALPHA_VALUE = 0;
-  DMA2D_FGConfig(&DMA2D_FG_InitStruct);
-
-  DMA2D_BG_InitTypeDef DMA2D_BG_InitStruct;
-  DMA2D_BG_StructInit(&DMA2D_BG_InitStruct);
-  DMA2D_BG_InitStruct.DMA2D_BGMA = CONVERT_PTR_UINT(dest + y * destw + x);
-  DMA2D_BG_InitStruct.DMA2D_BGO = destw - w;
-  DMA2D_BG_InitStruct.DMA2D_BGCM = CM_RGB565;
-  DMA2D_BG_InitStruct.DMA2D_BGPFC_ALPHA_MODE = NO_MODIF_ALPHA_VALUE;
-  DMA2D_BG_InitStruct.DMA2D_BGPFC_ALPHA_VALUE = 0;
-  DMA2D_BGConfig(&DMA2D_BG_InitStruct);
-
-  /* Start Transfer */
-  DMA2D_StartTransfer();
-
-  /* Wait for CTC Flag activation */
-  while (DMA2D_GetFlagStatus(DMA2D_FLAG_TC) == RESET)
-    ;
+  DMAOperation * op = DMAAllocate();
+  op->mode = DMA2D_M2M_BLEND;
+  op->outputColorMode = DMA2D_RGB565;
+  op->outputAddress = CONVERT_PTR_UINT(dest + y * destw + x);
+  op->outputOffset = destw - w;
+  op->size = (w << 16) | h;
+  op->foregroundAddress = CONVERT_PTR_UINT(src + srcy * srcw + srcx);
+  op->foregroundOffset = srcw - w;
+  op->foregroundColorMode = CM_ARGB4444;
+  op->backgroundAddress = op->outputAddress;
+  op->backgroundOffset = op->outputOffset;
+  op->backgroundColorMode = CM_RGB565;
+  DMAPush();
 }
 
 void DMABitmapConvert(uint16_t *dest, const uint8_t *src, uint16_t w,
                       uint16_t h, uint32_t format)
 {
-  DMA2D_DeInit();
-
-  DMA2D_InitTypeDef DMA2D_InitStruct;
-  DMA2D_InitStruct.DMA2D_Mode = DMA2D_M2M_PFC;
-  DMA2D_InitStruct.DMA2D_CMode = format;
-  DMA2D_InitStruct.DMA2D_OutputMemoryAdd = CONVERT_PTR_UINT(dest);
-  DMA2D_InitStruct.DMA2D_OutputGreen = 0;
-  DMA2D_InitStruct.DMA2D_OutputBlue = 0;
-  DMA2D_InitStruct.DMA2D_OutputRed = 0;
-  DMA2D_InitStruct.DMA2D_OutputAlpha = 0;
-  DMA2D_InitStruct.DMA2D_OutputOffset = 0;
-  DMA2D_InitStruct.DMA2D_NumberOfLine = h;
-  DMA2D_InitStruct.DMA2D_PixelPerLine = w;
-  DMA2D_Init(&DMA2D_InitStruct);
-
-  DMA2D_FG_InitTypeDef DMA2D_FG_InitStruct;
-  DMA2D_FG_StructInit(&DMA2D_FG_InitStruct);
-  DMA2D_FG_InitStruct.DMA2D_FGMA = CONVERT_PTR_UINT(src);
-  DMA2D_FG_InitStruct.DMA2D_FGO = 0;
-  DMA2D_FG_InitStruct.DMA2D_FGCM = CM_ARGB8888;
-  DMA2D_FG_InitStruct.DMA2D_FGPFC_ALPHA_MODE = REPLACE_ALPHA_VALUE;
-  DMA2D_FG_InitStruct.DMA2D_FGPFC_ALPHA_VALUE = 0;
-  DMA2D_FGConfig(&DMA2D_FG_InitStruct);
-
-  /* Start Transfer */
-  DMA2D_StartTransfer();
-
-  /* Wait for CTC Flag activation */
-  while (DMA2D_GetFlagStatus(DMA2D_FLAG_TC) == RESET)
-    ;
+  DMAOperation * op = DMAAllocate();
+  op->mode = DMA2D_M2M_PFC;
+  op->outputColorMode = format;
+  op->outputAddress = CONVERT_PTR_UINT(dest);
+  op->size = (w << 16) | h;
+  op->foregroundAddress = CONVERT_PTR_UINT(src);
+  op->foregroundColorMode = CM_ARGB8888 | (REPLACE_ALPHA_VALUE << 16);
+  DMAPush();
+
+  // the source is freed by the caller as soon as we return
+  DMAWait();
 }
 
 void DMACopy(void *src, void *dest, unsigned len)
 {
-  DMA2D_DeInit();
-
-  DMA2D_InitTypeDef DMA2D_InitStruct;
-  DMA2D_InitStruct.DMA2D_Mode = DMA2D_M2M;
-  DMA2D_InitStruct.DMA2D_CMode = DMA2D_RGB565;
-  DMA2D_InitStruct.DMA2D_OutputMemoryAdd = CONVERT_PTR_UINT(dest);
-  DMA2D_InitStruct.DMA2D_OutputGreen = 0;
-  DMA2D_InitStruct.DMA2D_OutputBlue = 0;
-  DMA2D_InitStruct.DMA2D_OutputRed = 0;
-  DMA2D_InitStruct.DMA2D_OutputAlpha = 0;
-  DMA2D_InitStruct.DMA2D_OutputOffset = 0;
-  DMA2D_InitStruct.DMA2D_NumberOfLine = LCD_H;
-  DMA2D_InitStruct.DMA2D_PixelPerLine = LCD_W;
-  DMA2D_Init(&DMA2D_InitStruct);
-
-  DMA2D_FG_InitTypeDef DMA2D_FG_InitStruct;
-  DMA2D_FG_StructInit(&DMA2D_FG_InitStruct);
-  DMA2D_FG_InitStruct.DMA2D_FGMA = CONVERT_PTR_UINT(src);
-  DMA2D_FG_InitStruct.DMA2D_FGO = 0;
-  DMA2D_FG_InitStruct.DMA2D_FGCM = CM_RGB565;
-  DMA2D_FG_InitStruct.DMA2D_FGPFC_ALPHA_MODE = NO_MODIF_ALPHA_VALUE;
-  DMA2D_FG_InitStruct.DMA2D_FGPFC_ALPHA_VALUE = 0;
-  DMA2D_FGConfig(&DMA2D_FG_InitStruct);
-
-  /* Start Transfer */
-  DMA2D_StartTransfer();
-
-  /* Wait for CTC Flag activation */
-  while (DMA2D_GetFlagStatus(DMA2D_FLAG_TC) == RESET)
-    ;
+  DMAOperation * op = DMAAllocate();
+  op->mode = DMA2D_M2M;
+  op->outputColorMode = DMA2D_RGB565;
+  op->outputAddress = CONVERT_PTR_UINT(dest);
+  op->size = (LCD_W << 16) | LCD_H;
+  op->foregroundAddress = CONVERT_PTR_UINT(src);
+  op->foregroundColorMode = CM_RGB565;
+  DMAPush();
 }
 
 void lcdStoreBackupBuffer()
@@ -1359,6 +1340,8 @@ int lcdRestoreBackupBuffer()
 
 void lcdRefresh()
 {
+  DMAWait();
+
   if (CurrentLayer == LCD_FIRST_LAYER)
   {
     LTDC_LayerAlpha(LTDC_Layer1, 255);
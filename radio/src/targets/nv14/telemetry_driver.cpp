@@ -99,6 +99,9 @@ void telemetryPortInit(uint32_t baudrate, uint8_t mode)
 
   USART_Cmd(TELEMETRY_USART, ENABLE);
   USART_ITConfig(TELEMETRY_USART, USART_IT_RXNE, ENABLE);
+#if defined(TELEMETRY_RX_EVENTS)
+  USART_ITConfig(TELEMETRY_USART, USART_IT_IDLE, ENABLE);
+#endif
   NVIC_SetPriority(TELEMETRY_USART_IRQn, 6);
   NVIC_EnableIRQ(TELEMETRY_USART_IRQn);
 }
@@ -215,6 +218,9 @@ extern "C" void TELEMETRY_USART_IRQHandler(void)
 {
   DEBUG_INTERRUPT(INT_TELEM_USART);
   uint32_t status = TELEMETRY_USART->SR;
+#if defined(TELEMETRY_RX_EVENTS)
+  uint32_t events = status;
+#endif
 
   if ((status & USART_SR_TC) && (TELEMETRY_USART->CR1 & USART_CR1_TCIE)) {
     TELEMETRY_USART->CR1 &= ~USART_CR1_TCIE;
@@ -243,7 +249,20 @@ extern "C" void TELEMETRY_USART_IRQHandler(void)
 #endif
     }
     status = TELEMETRY_USART->SR;
+#if defined(TELEMETRY_RX_EVENTS)
+    events |= status;
+#endif
   }
+
+#if defined(TELEMETRY_RX_EVENTS)
+  // the idle flag is cleared by a read of DR after SR, done above when bytes were received
+  if (events & USART_FLAG_IDLE) {
+    if (status & USART_FLAG_IDLE) {
+      (void)TELEMETRY_USART->DR;
+    }
+    telemetryReceiveEvent(EXTERNAL_MODULE);
+  }
+#endif
 }
 
 // TODO we should have telemetry in an higher layer, functions above should move to a sport_driver.cpp
@@ -266,6 +285,44 @@ uint8_t telemetryGetByte(uint8_t * byte)
 #endif
 }
 
+// Contiguous block of received bytes, they stay in the fifo until telemetrySkipData() is called
+uint32_t telemetryGetData(const uint8_t ** data)
+{
+#if defined(AFHDS3)
+  if(moduleState[EXTERNAL_MODULE].protocol == PROTOCOL_CHANNELS_AFHDS3) {
+    return heartbeatTelemetryGetData(data);
+  }
+#endif
+
+#if defined(PCBX12S)
+  if (telemetryFifoMode & TELEMETRY_SERIAL_WITHOUT_DMA)
+    return telemetryNoDMAFifo.getContiguousData(*data);
+  else
+    return telemetryDMAFifo.getContiguousData(*data);
+#else
+  return telemetryNoDMAFifo.getContiguousData(*data);
+#endif
+}
+
+void telemetrySkipData(uint32_t count)
+{
+#if defined(AFHDS3)
+  if(moduleState[EXTERNAL_MODULE].protocol == PROTOCOL_CHANNELS_AFHDS3) {
+    heartbeatTelemetrySkipData(count);
+    return;
+  }
+#endif
+
+#if defined(PCBX12S)
+  if (telemetryFifoMode & TELEMETRY_SERIAL_WITHOUT_DMA)
+    telemetryNoDMAFifo.skip(count);
+  else
+    telemetryDMAFifo.skip(count);
+#else
+  telemetryNoDMAFifo.skip(count);
+#endif
+}
+
 void telemetryClearFifo()
 {
 #if defined(PCBX12S)
@@ -18,6 +18,7 @@
 #include "opentx.h"
 #include "simulcd.h"
 #include "touch.h"
+#include "mixer_timings.h"
 #include <QDebug>
 #include <QElapsedTimer>
 
@@ -412,6 +413,26 @@ const int OpenTxSimulator::getCapability(Capability cap)
   return ret;
 }
 
+QString OpenTxSimulator::getMixerTimings()
+{
+  QString csv = "Timing,Bucket width (us),Samples,Min (us),Avg (us),P99 (us),Max (us)";
+  for (int i = 0; i < TIMING_HISTOGRAM_BUCKETS; i++) {
+    csv += QString(",Bucket %1").arg(i + 1);
+  }
+  csv += "\n";
+
+  for (int i = 0; i < MIXER_TIMINGS_COUNT; i++) {
+    const TimingHistogram & histogram = mixerTimings[i];
+    csv += QString("%1,%2,%3,%4,%5,%6,%7").arg(mixerTimingNames[i]).arg(histogram.getBucketWidth()).arg(histogram.getCount())
+           .arg(histogram.getMin()).arg(histogram.getAvg()).arg(histogram.getPercentile(99)).arg(histogram.getMax());
+    for (int j = 0; j < TIMING_HISTOGRAM_BUCKETS; j++) {
+      csv += QString(",%1").arg(histogram.getBucket(j));
+    }
+    csv += "\n";
+  }
+  return csv;
+}
+
 void OpenTxSimulator::setLuaStateReloadPermanentScripts()
 {
 #if defined(LUA)
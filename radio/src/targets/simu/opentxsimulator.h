@@ -45,6 +45,7 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     virtual uint8_t getSensorInstance(uint16_t id, uint8_t defaultValue = 0);
     virtual uint16_t getSensorRatio(uint16_t id);
     virtual const int getCapability(Capability cap);
+    virtual QString getMixerTimings();
 
     static QVector<QIODevice *> tracebackDevices;
 
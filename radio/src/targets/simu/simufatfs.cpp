@@ -41,11 +41,13 @@
 
 #if MSVC_BUILD
   #include <direct.h>
+  #include <io.h>
   #include <stdlib.h>
   #include <sys/utime.h>
   #define mkdir(s, f) _mkdir(s)
 #else
   #include <sys/time.h>
+  #include <unistd.h>
   #include <utime.h>
 #endif
 
@@ -378,6 +380,23 @@ FRESULT f_lseek (FIL* fil, DWORD offset)
   return FR_OK;
 }
 
+FRESULT f_truncate (FIL* fil)
+{
+  if (fil && fil->obj.fs) {
+    fflush((FILE*)fil->obj.fs);
+#if MSVC_BUILD
+    int result = _chsize(_fileno((FILE*)fil->obj.fs), fil->fptr);
+#else
+    int result = ftruncate(fileno((FILE*)fil->obj.fs), fil->fptr);
+#endif
+    if (result) {
+      TRACE_SIMPGMSPACE("f_truncate(%p) = error %d (%s)", fil->obj.fs, errno, strerror(errno));
+      return FR_DISK_ERR;
+    }
+  }
+  return FR_OK;
+}
+
 UINT f_size(FIL* fil)
 {
   if (fil && fil->obj.fs) {
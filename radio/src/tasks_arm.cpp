@@ -21,6 +21,7 @@
 #include "opentx.h"
 #include "shutdown_animation.h"
 #include "mixer_scheduler.h"
+#include "mixer_timings.h"
 
 RTOS_TASK_HANDLE menusTaskId;
 RTOS_DEFINE_STACK(menusStack, MENUS_STACK_SIZE);
@@ -34,6 +35,11 @@ RTOS_DEFINE_STACK(audioStack, AUDIO_STACK_SIZE);
 RTOS_TASK_HANDLE telemetryTaskId;
 RTOS_DEFINE_STACK(telemetryStack, TELEMETRY_STACK_SIZE);
 
+#if defined(LOG_BINARY)
+RTOS_TASK_HANDLE logsTaskId;
+RTOS_DEFINE_STACK(logsStack, LOGS_STACK_SIZE);
+#endif
+
 RTOS_MUTEX_HANDLE audioMutex;
 RTOS_MUTEX_HANDLE mixerMutex;
 
@@ -57,6 +63,9 @@ void stackPaint()
   mixerStack.paint();
   audioStack.paint();
   telemetryStack.paint();
+#if defined(LOG_BINARY)
+  logsStack.paint();
+#endif
 #if defined(CLI)
   cliStack.paint();
 #endif
@@ -122,17 +131,25 @@ bool isModuleSynchronous(uint8_t moduleIdx)
   return false;
 }
 
-void sendSynchronousPulses()
+// returns the time (2MHz timer) when the last frame was sent, or mixerEnd when no frame was sent
+uint16_t sendSynchronousPulses(uint16_t mixerEnd)
 {
+  uint16_t sent = mixerEnd;
 #if defined(HARDWARE_INTERNAL_MODULE)
   if (isModuleSynchronous(INTERNAL_MODULE) && setupPulsesInternalModule()) {
     intmoduleSendNextFrame();
+    sent = getTmr2MHz();
+    mixerTimings[MIXER_TIMING_INTERNAL_PULSES].add((uint16_t)(sent - mixerEnd) / 2);
   }
 #endif
   if (isModuleSynchronous(EXTERNAL_MODULE)) {
-    if (setupPulsesExternalModule())
+    if (setupPulsesExternalModule()) {
       extmoduleSendNextFrame();
+      sent = getTmr2MHz();
+      mixerTimings[MIXER_TIMING_EXTERNAL_PULSES].add((uint16_t)(sent - mixerEnd) / 2);
+    }
   }
+  return sent;
 }
 
 RTOS_FLAG_HANDLE telemetryFlag;
@@ -145,10 +162,10 @@ TASK_FUNCTION(telemetryTask)
     TASK_RETURN();
   }
 #endif
-  // if(!telemetryFlag) 
-  //   break;
-  RTOS_CLEAR_FLAG(telemetryFlag);
+  // woken up by the receive interrupts (TELEMETRY_RX_EVENTS) or the mixer, 10ms at most.
+  // The flag is cleared before the fifos are drained, an event during telemetryWakeup() is not lost
   RTOS_WAIT_FLAG(telemetryFlag, 10);
+  RTOS_CLEAR_FLAG(telemetryFlag);
   DEBUG_TIMER_START(debugTimerTelemetryWakeup);
   telemetryWakeup();
   DEBUG_TIMER_STOP(debugTimerTelemetryWakeup);
@@ -158,10 +175,12 @@ TASK_FUNCTION(telemetryTask)
 
 TASK_FUNCTION(mixerTask)
 {
+  bool lastTriggerValid = false;
+  uint16_t lastTrigger = 0;
+
   s_pulses_paused = true;
   mixerSchedulerInit();
   mixerSchedulerStart();
-  RTOS_CREATE_FLAG(telemetryFlag);
   while(1) {
 #if defined(SBUS_TRAINER)
     processSbusInput();
@@ -188,6 +207,19 @@ TASK_FUNCTION(mixerTask)
 
     if (!s_pulses_paused) {
       uint16_t t0 = getTmr2MHz();
+      uint16_t trigger = (timeout ? t0 : getMixerSchedulerTriggerTime());
+      if (!timeout) {
+        mixerTimings[MIXER_TIMING_TRIGGER_LATENCY].add((uint16_t)(t0 - trigger) / 2);
+#if !defined(SIMU)
+        if (lastTriggerValid) {
+          int32_t period = (uint16_t)(trigger - lastTrigger) / 2;
+          mixerTimings[MIXER_TIMING_PERIOD_JITTER].add(abs(period - (int32_t)getMixerSchedulerPeriod()));
+        }
+#endif
+      }
+      lastTriggerValid = !timeout;
+      lastTrigger = trigger;
+
       DEBUG_TIMER_START(debugTimerMixer);
       RTOS_LOCK_MUTEX(mixerMutex);
       doMixerCalculations();
@@ -211,9 +243,11 @@ TASK_FUNCTION(mixerTask)
         heartbeat = 0;
       }
 
-      t0 = getTmr2MHz() - t0;
+      uint16_t mixerEnd = getTmr2MHz();
+      t0 = mixerEnd - t0;
       if (t0 > maxMixerDuration) 
         maxMixerDuration = t0;
+      mixerTimings[MIXER_TIMING_DURATION].add(t0 / 2);
       
       // TODO:
       // - check the cause of timeouts when switching
@@ -221,7 +255,13 @@ TASK_FUNCTION(mixerTask)
       if (timeout)
         TRACE("mix sched timeout!");
 
-      sendSynchronousPulses();
+      uint16_t sent = sendSynchronousPulses(mixerEnd);
+      if (!timeout) {
+        mixerTimings[MIXER_TIMING_END_TO_END].add((uint16_t)(sent - trigger) / 2);
+      }
+    }
+    else {
+      lastTriggerValid = false;
     }
   }
 }
@@ -328,6 +368,7 @@ void tasksStart()
   cliStart();
 #endif
 
+  RTOS_CREATE_FLAG(telemetryFlag);
   RTOS_CREATE_TASK(mixerTaskId, mixerTask, "Mixer", mixerStack, MIXER_STACK_SIZE, MIXER_TASK_PRIO);
   RTOS_CREATE_TASK(telemetryTaskId, telemetryTask, "Telemetry", telemetryStack, TELEMETRY_STACK_SIZE, TELEMETRY_TASK_PRIO);
   RTOS_CREATE_TASK(menusTaskId, menusTask, "Menus", menusStack,  MENUS_STACK_SIZE, MENUS_TASK_PRIO);
@@ -336,6 +377,11 @@ void tasksStart()
   RTOS_CREATE_TASK(audioTaskId, audioTask, "Audio", audioStack, AUDIO_STACK_SIZE, AUDIO_TASK_PRIO);
 #endif
 
+#if defined(LOG_BINARY)
+  RTOS_CREATE_FLAG(logsFlag);
+  RTOS_CREATE_TASK(logsTaskId, logsTask, "Logs", logsStack, LOGS_STACK_SIZE, LOGS_TASK_PRIO);
+#endif
+
 #if IS_TOUCH_ENABLED()
   TouchManager::instance()->init();  // init touch task
 #endif
@@ -28,6 +28,7 @@
 #define MIXER_STACK_SIZE       300 //504
 #define TELEMETRY_STACK_SIZE   240 
 #define AUDIO_STACK_SIZE       500
+#define LOGS_STACK_SIZE        400
 #define TOUCH_STACK_SIZE       100  // TODO: this can be reduced a lot after debug (tracing) is done (on last check only 42 Words are actually used)
 #define BLUETOOTH_STACK_SIZE   504  // WTF: there is no BT task.... ???
 
@@ -35,6 +36,7 @@
 #define TELEMETRY_TASK_PRIO    6
 #define AUDIO_TASK_PRIO        7
 #define MENUS_TASK_PRIO        10
+#define LOGS_TASK_PRIO         11   // lower prio than GUI, the SD writes are done in the background
 #define CLI_TASK_PRIO          10
 #define TOUCH_TASK_PRIO        12   // lower prio than GUI! otherwise may block (runs at 1 tick)
 
@@ -50,7 +52,13 @@ extern RTOS_DEFINE_STACK(telemetryStack, TELEMETRY_STACK_SIZE);
 extern RTOS_TASK_HANDLE audioTaskId;
 extern RTOS_DEFINE_STACK(audioStack, AUDIO_STACK_SIZE);
 
+#if defined(LOG_BINARY)
+extern RTOS_TASK_HANDLE logsTaskId;
+extern RTOS_DEFINE_STACK(logsStack, LOGS_STACK_SIZE);
+#endif
+
 extern RTOS_FLAG_HANDLE openTxInitCompleteFlag;
+extern RTOS_FLAG_HANDLE telemetryFlag;
 
 void stackPaint();
 void tasksStart();
@@ -273,6 +273,38 @@ void processCrossfireTelemetryData(uint8_t data)
   }
 }
 
+// Same parsing as processCrossfireTelemetryData(), on a whole block of received bytes:
+// garbage is skipped up to the next address byte and the frame bodies are copied at once
+void processCrossfireTelemetryBuffer(const uint8_t * data, uint32_t count)
+{
+  const uint8_t * end = data + count;
+
+  while (data < end) {
+    if (telemetryRxBufferCount == 0 && *data != RADIO_ADDRESS) {
+      TRACE("[XF] address 0x%02X error", *data);
+      crossfireError = true;
+      data = (const uint8_t *)memchr(data, RADIO_ADDRESS, end - data);
+      if (!data)
+        return;
+    }
+
+    if (telemetryRxBufferCount >= 2 && telemetryRxBuffer[1] > 2) {
+      uint8_t length = telemetryRxBuffer[1];
+      uint32_t size = min<uint32_t>(length + 2 - telemetryRxBufferCount, end - data);
+      memcpy(&telemetryRxBuffer[telemetryRxBufferCount], data, size);
+      telemetryRxBufferCount += size;
+      data += size;
+      if (length + 2 == telemetryRxBufferCount) {
+        processCrossfireTelemetryFrame();
+        telemetryRxBufferCount = 0;
+      }
+    }
+    else {
+      processCrossfireTelemetryData(*data++);
+    }
+  }
+}
+
 void crossfireSetDefault(int index, uint8_t id, uint8_t subId)
 {
   TelemetrySensor & telemetrySensor = g_model.telemetrySensors[index];
@@ -64,6 +64,8 @@ void flySkyNv14SetDefault(int index, uint8_t id, uint8_t subId, uint8_t instance
 void flySkyNv14ProcessTelemetryPacket(const uint8_t * ptr, uint8_t SensorType );
 void processInternalFlySkyTelemetryData(uint8_t byte);
 uint8_t intmoduleGetByte(uint8_t * byte);
+uint32_t intmoduleGetData(const uint8_t ** data);
+void intmoduleSkipData(uint32_t count);
 
 extern bool syncAfhds2Module;
 #endif
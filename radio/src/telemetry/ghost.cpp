@@ -237,7 +237,7 @@ void processGhostTelemetryFrame()
   }
 }
 
-void processGhostTelemetryData(uint8_t data)
+static void mirrorGhostTelemetryData(uint8_t data)
 {
 #if defined(AUX_SERIAL)
   if (g_eeGeneral.auxSerialMode == UART_MODE_TELEMETRY_MIRROR) {
@@ -250,7 +250,10 @@ void processGhostTelemetryData(uint8_t data)
     aux2SerialPutc(data);
   }
 #endif
+}
 
+static void parseGhostTelemetryData(uint8_t data)
+{
   if (telemetryRxBufferCount == 0 && data != GHST_ADDR_RADIO) {
     TRACE("[GH] address 0x%02X error", data);
     return;
@@ -273,6 +276,47 @@ void processGhostTelemetryData(uint8_t data)
   }
 }
 
+void processGhostTelemetryData(uint8_t data)
+{
+  mirrorGhostTelemetryData(data);
+  parseGhostTelemetryData(data);
+}
+
+// Same parsing as processGhostTelemetryData(), on a whole block of received bytes:
+// garbage is skipped up to the next address byte and the frame bodies are copied at once
+void processGhostTelemetryBuffer(const uint8_t * data, uint32_t count)
+{
+  const uint8_t * end = data + count;
+
+  for (const uint8_t * p = data; p < end; p++) {
+    mirrorGhostTelemetryData(*p);
+  }
+
+  while (data < end) {
+    if (telemetryRxBufferCount == 0 && *data != GHST_ADDR_RADIO) {
+      TRACE("[GH] address 0x%02X error", *data);
+      data = (const uint8_t *)memchr(data, GHST_ADDR_RADIO, end - data);
+      if (!data)
+        return;
+    }
+
+    uint8_t length = telemetryRxBuffer[1];
+    if (telemetryRxBufferCount >= 2 && length > 2 && length + 2 <= TELEMETRY_RX_PACKET_SIZE) {
+      uint32_t size = min<uint32_t>(length + 2 - telemetryRxBufferCount, end - data);
+      memcpy(&telemetryRxBuffer[telemetryRxBufferCount], data, size);
+      telemetryRxBufferCount += size;
+      data += size;
+      if (length + 2 == telemetryRxBufferCount) {
+        processGhostTelemetryFrame();
+        telemetryRxBufferCount = 0;
+      }
+    }
+    else {
+      parseGhostTelemetryData(*data++);
+    }
+  }
+}
+
 
 void ghostSetDefault(int index, uint8_t id, uint8_t subId)
 {
@@ -98,6 +98,7 @@ enum GhstVtxBand
 };
 
 void processGhostTelemetryData(uint8_t data);
+void processGhostTelemetryBuffer(const uint8_t * data, uint32_t count);
 void ghostSetDefault(int index, uint8_t id, uint8_t subId);
 
 #if SPORT_MAX_BAUDRATE < 400000
@@ -44,6 +44,61 @@ uint8_t telemetryProtocol = 255;
 uint8_t serialInversion = 0;
 #endif
 
+#if defined(TELEMETRY_RX_EVENTS)
+TimingHistogram telemetryLatency[PROTOCOL_TELEMETRY_LAST+1];
+
+const char * const telemetryProtocolNames[PROTOCOL_TELEMETRY_LAST+1] = {
+  "FrSky S.Port",
+  "FrSky D",
+  "FrSky D (2nd)",
+  "Crossfire",
+  "Spektrum",
+  "FlySky iBus",
+  "Hitec",
+  "HoTT",
+  "Multi",
+  "FlySky NV14",
+  "AFHDS3",
+  "Ghost",
+};
+
+static volatile bool telemetryEventPending[NUM_MODULES];
+static uint16_t telemetryEventTime[NUM_MODULES];
+
+// only the first event is timed, until the telemetry task has taken it
+void telemetryReceiveEvent(uint8_t module)
+{
+  if (!telemetryEventPending[module]) {
+    telemetryEventTime[module] = getTmr2MHz();
+    telemetryEventPending[module] = true;
+  }
+  RTOS_ISR_SET_FLAG(telemetryFlag);
+}
+
+static bool telemetryTakeEvent(uint8_t module, uint16_t & time)
+{
+  if (!telemetryEventPending[module])
+    return false;
+  time = telemetryEventTime[module];
+  telemetryEventPending[module] = false;
+  return true;
+}
+
+static void telemetryAddLatency(uint8_t protocol, uint16_t time)
+{
+  if (protocol <= PROTOCOL_TELEMETRY_LAST) {
+    telemetryLatency[protocol].add((uint16_t)(getTmr2MHz() - time) / 2);
+  }
+}
+
+void telemetryLatencyReset()
+{
+  for (uint8_t i=0; i<=PROTOCOL_TELEMETRY_LAST; i++) {
+    telemetryLatency[i].reset();
+  }
+}
+#endif
+
 #if !defined(CPUARM)
 uint16_t getChannelRatio(source_t channel)
 {
@@ -95,6 +150,28 @@ void processTelemetryData(uint8_t data)
   processFrskyTelemetryData(data);
 }
 
+#if defined(PCBNV14)
+// A whole block of received bytes, Crossfire and Ghost parse it at once
+void processTelemetryBuffer(const uint8_t * data, uint32_t count)
+{
+#if defined(CROSSFIRE)
+  if (telemetryProtocol == PROTOCOL_TELEMETRY_CROSSFIRE) {
+    processCrossfireTelemetryBuffer(data, count);
+    return;
+  }
+#endif
+#if defined(GHOST)
+  if (telemetryProtocol == PROTOCOL_TELEMETRY_GHOST) {
+    processGhostTelemetryBuffer(data, count);
+    return;
+  }
+#endif
+  for (uint32_t i=0; i<count; i++) {
+    processTelemetryData(data[i]);
+  }
+}
+#endif
+
 void telemetryWakeup()
 {
 #if defined(CPUARM)
@@ -110,7 +187,45 @@ void telemetryWakeup()
   }
 #endif
 
-#if defined(STM32)
+#if defined(PCBNV14)
+#if defined(TELEMETRY_RX_EVENTS)
+  uint16_t eventTime[NUM_MODULES];
+  bool externalEvent = telemetryTakeEvent(EXTERNAL_MODULE, eventTime[EXTERNAL_MODULE]);
+  bool internalEvent = telemetryTakeEvent(INTERNAL_MODULE, eventTime[INTERNAL_MODULE]);
+#endif
+
+  // the received bytes are parsed in place, one contiguous block of the fifo at a time
+  const uint8_t * data;
+  uint32_t count;
+  if (!moduleUpdateActive(EXTERNAL_MODULE) && (count = telemetryGetData(&data)) > 0) {
+    LOG_TELEMETRY_WRITE_START();
+    do {
+      processTelemetryBuffer(data, count);
+      for (uint32_t i=0; i<count; i++) {
+        LOG_TELEMETRY_WRITE_BYTE(data[i]);
+      }
+      telemetrySkipData(count);
+    } while ((count = telemetryGetData(&data)) > 0);
+  }
+  if(!moduleUpdateActive(INTERNAL_MODULE) && moduleState[INTERNAL_MODULE].protocol == PROTOCOL_CHANNELS_AFHDS2 && (count = intmoduleGetData(&data)) > 0) {
+    do {
+      for (uint32_t i=0; i<count; i++) {
+        processInternalFlySkyTelemetryData(data[i]);
+        LOG_TELEMETRY_WRITE_BYTE(data[i]);
+      }
+      intmoduleSkipData(count);
+    } while ((count = intmoduleGetData(&data)) > 0);
+  }
+
+#if defined(TELEMETRY_RX_EVENTS)
+  if (externalEvent) {
+    telemetryAddLatency(telemetryProtocol, eventTime[EXTERNAL_MODULE]);
+  }
+  if (internalEvent) {
+    telemetryAddLatency(PROTOCOL_TELEMETRY_FLYSKY_NV14, eventTime[INTERNAL_MODULE]);
+  }
+#endif
+#elif defined(STM32)
   uint8_t data;
   if (!moduleUpdateActive(EXTERNAL_MODULE) && telemetryGetByte(&data)) {
     LOG_TELEMETRY_WRITE_START();
@@ -119,14 +234,6 @@ void telemetryWakeup()
       LOG_TELEMETRY_WRITE_BYTE(data);
     } while (telemetryGetByte(&data));
   }
-#if defined(PCBNV14)
-  if(!moduleUpdateActive(INTERNAL_MODULE) && moduleState[INTERNAL_MODULE].protocol == PROTOCOL_CHANNELS_AFHDS2 && intmoduleGetByte(&data)) {
-    do {
-      processInternalFlySkyTelemetryData(data);
-      LOG_TELEMETRY_WRITE_BYTE(data);
-    } while (intmoduleGetByte(&data));
-  }
- #endif
 #elif defined(PCBSKY9X)
   if (telemetryProtocol == PROTOCOL_TELEMETRY_FRSKY_D_SECONDARY) {
     uint8_t data;
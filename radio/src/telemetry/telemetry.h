@@ -148,6 +148,7 @@ int setTelemetryText(TelemetryProtocol protocol, uint16_t id, uint8_t subId, uin
 
 void delTelemetryIndex(uint8_t index);
 int8_t availableTelemetryIndex();
+void invalidateTelemetrySensorsIndex();
 int lastUsedTelemetryIndex();
 
 int32_t getTelemetryValue(uint8_t index, uint8_t & prec);
@@ -234,6 +235,16 @@ inline uint8_t modelTelemetryProtocol()
   #include "telemetry_sensors.h"
 #endif
 
+#if defined(TELEMETRY_RX_EVENTS)
+#include "mixer_timings.h"
+// Called by the receive interrupts when the line gets idle after a frame, wakes up the telemetry task
+void telemetryReceiveEvent(uint8_t module);
+// Per protocol, from the end of a frame on the line to the end of its parsing
+extern TimingHistogram telemetryLatency[PROTOCOL_TELEMETRY_LAST+1];
+extern const char * const telemetryProtocolNames[PROTOCOL_TELEMETRY_LAST+1];
+void telemetryLatencyReset();
+#endif
+
 #if defined(LOG_TELEMETRY) && !defined(SIMU)
 void logTelemetryWriteStart();
 void logTelemetryWriteByte(uint8_t data);
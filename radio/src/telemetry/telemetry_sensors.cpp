@@ -409,6 +409,7 @@ void delTelemetryIndex(uint8_t index)
 {
   memclear(&g_model.telemetrySensors[index], sizeof(TelemetrySensor));
   telemetryItems[index].clear();
+  invalidateTelemetrySensorsIndex();
   storageDirty(EE_MODEL);
 }
 
@@ -435,6 +436,37 @@ int lastUsedTelemetryIndex()
 }
 
 
+// Custom sensors indexed by id / subId, rebuilt on the next lookup after a model change.
+// The instance is not part of the key, as isSameInstance() does not only compare it.
+#define TELEMETRY_SENSORS_HASH_SIZE    32
+#define TELEMETRY_SENSORS_HASH(id, subId) (((id) ^ ((id) >> 5) ^ ((id) >> 10) ^ (subId)) & (TELEMETRY_SENSORS_HASH_SIZE - 1))
+#define TELEMETRY_SENSORS_HASH_END     -1
+
+int8_t telemetrySensorsHash[TELEMETRY_SENSORS_HASH_SIZE];
+int8_t telemetrySensorsNext[MAX_TELEMETRY_SENSORS];   // next sensor with the same hash, in index order
+bool telemetrySensorsIndexDirty = true;
+
+void invalidateTelemetrySensorsIndex()
+{
+  telemetrySensorsIndexDirty = true;
+}
+
+void buildTelemetrySensorsIndex()
+{
+  // cleared first, another task may change the sensors again while the index is built
+  telemetrySensorsIndexDirty = false;
+
+  memset(telemetrySensorsHash, TELEMETRY_SENSORS_HASH_END, sizeof(telemetrySensorsHash));
+  for (int index = MAX_TELEMETRY_SENSORS - 1; index >= 0; index--) {
+    TelemetrySensor & telemetrySensor = g_model.telemetrySensors[index];
+    if (telemetrySensor.type == TELEM_TYPE_CUSTOM) {
+      uint8_t hash = TELEMETRY_SENSORS_HASH(telemetrySensor.id, telemetrySensor.subId);
+      telemetrySensorsNext[index] = telemetrySensorsHash[hash];
+      telemetrySensorsHash[hash] = index;
+    }
+  }
+}
+
 bool isSameInstance(TelemetrySensor& sensor, TelemetryProtocol protocol, uint8_t instance)
 {
   if (sensor.instance == instance)
@@ -472,19 +504,33 @@ int setTelemetryText(TelemetryProtocol protocol, uint16_t id, uint8_t subId, uin
   return result;
 }
 
+static bool setCustomSensorValue(int index, TelemetryProtocol protocol, uint16_t id,
+                                 uint8_t subId, uint8_t instance,
+                                 int32_t value, uint32_t unit, uint32_t prec)
+{
+  TelemetrySensor & telemetrySensor = g_model.telemetrySensors[index];
+  if (telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id && telemetrySensor.subId == subId
+       && (isSameInstance(telemetrySensor, protocol, instance)  || g_model.ignoreSensorIds)
+      )
+  {
+    telemetryItems[index].setValue(telemetrySensor, value, unit, prec);
+    return true;
+  }
+  return false;
+}
+
 int setTelemetryValue(TelemetryProtocol protocol, uint16_t id,
                       uint8_t subId, uint8_t instance,
                       int32_t value, uint32_t unit, uint32_t prec)
 {
   bool sensorFound = false;
 
-  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
-    TelemetrySensor & telemetrySensor = g_model.telemetrySensors[index];
-    if (telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id && telemetrySensor.subId == subId
-         && (isSameInstance(telemetrySensor, protocol, instance)  || g_model.ignoreSensorIds)
-        )
-    {
-      telemetryItems[index].setValue(telemetrySensor, value, unit, prec);
+  if (telemetrySensorsIndexDirty) {
+    buildTelemetrySensorsIndex();
+  }
+
+  for (int index = telemetrySensorsHash[TELEMETRY_SENSORS_HASH(id, subId)]; index != TELEMETRY_SENSORS_HASH_END; index = telemetrySensorsNext[index]) {
+    if (setCustomSensorValue(index, protocol, id, subId, instance, value, unit, prec)) {
       sensorFound = true;
       // we continue search here, because sensors can share the same id and instance
     }
@@ -492,6 +538,16 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id,
   if (sensorFound || !allowNewSensors) {
     return -1;
   }
+  // the sensor may have been added by another task since the index was built
+  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+    if (setCustomSensorValue(index, protocol, id, subId, instance, value, unit, prec)) {
+      sensorFound = true;
+    }
+  }
+  invalidateTelemetrySensorsIndex();
+  if (sensorFound) {
+    return -1;
+  }
   int index = availableTelemetryIndex();
   if (index >= 0) {
     switch (protocol) {
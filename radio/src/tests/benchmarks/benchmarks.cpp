@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <stdlib.h>
+#include "benchmarks.h"
+
+uint16_t anaInValues[NUM_STICKS+NUM_POTS+NUM_SLIDERS] = { 0 };
+uint16_t anaIn(uint8_t chan)
+{
+  if (chan < NUM_STICKS+NUM_POTS+NUM_SLIDERS)
+    return anaInValues[chan];
+  else
+    return 0;
+}
+
+uint16_t getAnalogValue(uint8_t index)
+{
+  return anaIn(index);
+}
+
+static const char * benchmarkFilter = NULL;
+
+double benchmarkClockOverhead = 0;
+
+// the filter is matched against "suite/fixture"
+bool benchmarkSelected(const char * suite, const char * fixture)
+{
+  if (!benchmarkFilter)
+    return true;
+
+  char name[64];
+  snprintf(name, sizeof(name), "%s/%s", suite, fixture);
+  return strstr(name, benchmarkFilter) != NULL;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t iterations = BENCHMARK_DEFAULT_ITERATIONS;
+
+  for (int i=1; i<argc; i++) {
+    if (!strcmp(argv[i], "-n") && i+1 < argc) {
+      iterations = strtoul(argv[++i], NULL, 10);
+    }
+    else if (argv[i][0] != '-') {
+      benchmarkFilter = argv[i];
+    }
+    else {
+      printf("Usage: %s [-n iterations] [suite/fixture filter]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  if (iterations == 0) {
+    iterations = 1;
+  }
+
+  simuInit();
+  menuLevel = 0;
+
+  benchmarkClockOverhead = benchmarkMeasure(iterations, [](uint32_t) {}, [](uint32_t) {});
+  printf("clock overhead %.1f ns/iteration, subtracted from the stages measured alone\n", benchmarkClockOverhead);
+
+  runMixerBenchmarks(iterations);
+
+  return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _BENCHMARKS_H_
+#define _BENCHMARKS_H_
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#define SWAP_DEFINED
+#include "opentx.h"
+
+#define BENCHMARK_DEFAULT_ITERATIONS   1000000
+
+extern uint16_t anaInValues[NUM_STICKS+NUM_POTS+NUM_SLIDERS];
+
+// Runs body(iteration) the given number of times, returns the mean duration in ns
+template <class T>
+double benchmarkMeasure(uint32_t iterations, T body)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i=0; i<iterations; i++) {
+    body(i);
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(duration).count() / iterations;
+}
+
+// mean cost of reading the clock around an empty body, see benchmarkMeasure(iterations, prepare, body)
+extern double benchmarkClockOverhead;
+
+// Runs prepare(iteration) then body(iteration) the given number of times, returns the mean duration of body alone in ns
+template <class P, class T>
+double benchmarkMeasure(uint32_t iterations, P prepare, T body)
+{
+  std::chrono::steady_clock::duration duration = std::chrono::steady_clock::duration::zero();
+  for (uint32_t i=0; i<iterations; i++) {
+    prepare(i);
+    auto start = std::chrono::steady_clock::now();
+    body(i);
+    duration += std::chrono::steady_clock::now() - start;
+  }
+  return std::chrono::duration<double, std::nano>(duration).count() / iterations - benchmarkClockOverhead;
+}
+
+inline void benchmarkPrintHeader(const char * suite, const char * fixture, uint32_t iterations)
+{
+  printf("%s/%s (%u iterations)\n", suite, fixture, iterations);
+}
+
+inline void benchmarkPrintResult(const char * stage, double ns)
+{
+  printf("  %-24s %10.1f ns/iteration\n", stage, ns);
+}
+
+bool benchmarkSelected(const char * suite, const char * fixture);
+
+void runMixerBenchmarks(uint32_t iterations);
+
+#endif // _BENCHMARKS_H_
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "benchmarks.h"
+
+#define STICKS_SWEEP_LENGTH            1024
+
+static int16_t sticksSweep[STICKS_SWEEP_LENGTH];
+
+// all sticks / pots follow the same triangle wave, each one with its own phase
+static void moveSticks(uint32_t iteration)
+{
+  for (uint8_t i=0; i<NUM_STICKS+NUM_POTS+NUM_SLIDERS; i++) {
+    anaInValues[i] = sticksSweep[(iteration + i*(STICKS_SWEEP_LENGTH/7)) % STICKS_SWEEP_LENGTH];
+  }
+}
+
+static void mixerReset()
+{
+  generalDefault();
+  g_eeGeneral.templateSetup = 0;
+  modelDefault(0);
+
+  memclear(anaInValues, sizeof(anaInValues));
+  memclear(channelOutputs, sizeof(channelOutputs));
+  memclear(chans, sizeof(chans));
+  memclear(ex_chans, sizeof(ex_chans));
+  memclear(act, sizeof(act));
+  memclear(swOn, sizeof(swOn));
+  s_mixer_first_run_done = false;
+  mixerCurrentFlightMode = 0;
+  lastFlightMode = 255;
+  logicalSwitchesReset();
+  customFunctionsReset();
+}
+
+static MixData * setMix(uint8_t index, uint8_t channel, mixsrc_t source, int16_t weight=100)
+{
+  MixData * md = mixAddress(index);
+  md->destCh = channel;
+  md->srcRaw = source;
+  md->weight = weight;
+  md->mltpx = MLTPX_ADD;
+  return md;
+}
+
+static void setupPlainModel()
+{
+  // default template (4 inputs / 4 channels) + expo and a few auxiliary channels
+  for (uint8_t i=0; i<NUM_STICKS; i++) {
+    ExpoData * ed = expoAddress(i);
+    ed->curve.type = CURVE_REF_EXPO;
+    ed->curve.value = 30;
+  }
+
+  uint8_t index = NUM_STICKS;
+  for (uint8_t ch=NUM_STICKS; ch<8; ch++) {
+    setMix(index++, ch, MIXSRC_FIRST_POT + (ch - NUM_STICKS) % (NUM_POTS+NUM_SLIDERS));
+  }
+}
+
+#if defined(HELI)
+static void setupHeliModel()
+{
+  g_model.swashR.type = SWASH_TYPE_120;
+  g_model.swashR.collectiveSource = MIXSRC_Thr;
+  g_model.swashR.elevatorSource = MIXSRC_Ele;
+  g_model.swashR.aileronSource = MIXSRC_Ail;
+  g_model.swashR.collectiveWeight = 60;
+  g_model.swashR.elevatorWeight = 100;
+  g_model.swashR.aileronWeight = 100;
+  g_model.swashR.value = 80;
+
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  setMix(0, 0, MIXSRC_CYC1);
+  setMix(1, 1, MIXSRC_CYC2);
+  setMix(2, 2, MIXSRC_CYC3);
+  MixData * md = setMix(3, 3, MIXSRC_Rud);
+  md->curve.type = CURVE_REF_DIFF;
+  md->curve.value = 20;
+  // throttle curve and gyro gain
+  md = setMix(4, 5, MIXSRC_Thr);
+  md->curve.type = CURVE_REF_CUSTOM;
+  md->curve.value = 1;
+  setMix(5, 6, MIXSRC_FIRST_POT, 50);
+  for (int8_t i=-2; i<=2; i++) {
+    g_model.points[2+i] = 20*i + 40;
+  }
+  LOAD_MODEL_CURVES();
+}
+#endif
+
+static void setupFlightModesModel()
+{
+  // L1..L8 are set one after the other when the throttle goes up, each one selects a flight mode
+  for (uint8_t fm=1; fm<MAX_FLIGHT_MODES; fm++) {
+    LogicalSwitchData * ls = lswAddress(fm-1);
+    ls->func = LS_FUNC_VPOS;
+    ls->v1 = MIXSRC_Thr;
+    ls->v2 = -1024 + fm * (2048 / MAX_FLIGHT_MODES);
+    g_model.flightModeData[MAX_FLIGHT_MODES-fm].swtch = SWSRC_SW1 + fm - 1;
+  }
+  for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
+    g_model.flightModeData[fm].fadeIn = 5;
+    g_model.flightModeData[fm].fadeOut = 5;
+  }
+
+  // 32 channels, with one line per flight mode on the first 4 ones
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  uint8_t index = 0;
+  for (uint8_t ch=0; ch<MAX_OUTPUT_CHANNELS && index<MAX_MIXERS; ch++) {
+    if (ch < NUM_STICKS) {
+      for (uint8_t fm=0; fm<MAX_FLIGHT_MODES && index<MAX_MIXERS; fm++) {
+        MixData * md = setMix(index++, ch, MIXSRC_FIRST_INPUT + ch, 60 + 5*fm);
+        md->flightModes = ((1 << MAX_FLIGHT_MODES) - 1) & ~(1 << fm);
+      }
+    }
+    else {
+      setMix(index++, ch, MIXSRC_FIRST_STICK + ch % NUM_STICKS);
+    }
+  }
+}
+
+static void setupGVarsModel()
+{
+  for (uint8_t gv=0; gv<MAX_GVARS; gv++) {
+    g_model.flightModeData[0].gvars[gv] = 10 * (gv + 1);
+  }
+
+  // weights and offsets from GVARs, with a channel reading another one
+  memclear(g_model.mixData, sizeof(g_model.mixData));
+  uint8_t index = 0;
+  for (uint8_t ch=0; ch<16; ch++) {
+    MixData * md = setMix(index++, ch, ch < NUM_STICKS ? MIXSRC_FIRST_INPUT + ch : MIXSRC_CH1 + ch - NUM_STICKS);
+    md->weight = GV_CALC_VALUE_IDX_POS(ch % MAX_GVARS, GV1_LARGE);
+    md->offset = GV_CALC_VALUE_IDX_POS((ch + 1) % MAX_GVARS, GV1_LARGE);
+    md = setMix(index++, ch, MIXSRC_FIRST_GVAR + ch % MAX_GVARS, 25);
+    md->swtch = SWSRC_SW1 + ch;
+  }
+
+  // logical switches comparing GVARs and sticks, special functions adjusting the GVARs
+  for (uint8_t i=0; i<32; i++) {
+    LogicalSwitchData * ls = lswAddress(i);
+    ls->func = (i & 1) ? LS_FUNC_GREATER : LS_FUNC_APOS;
+    ls->v1 = MIXSRC_FIRST_GVAR + i % MAX_GVARS;
+    ls->v2 = (i & 1) ? MIXSRC_FIRST_STICK + i % NUM_STICKS : 20;
+  }
+  for (uint8_t i=0; i<MAX_GVARS; i++) {
+    CustomFunctionData * cfn = &g_model.customFn[i];
+    CFN_SWITCH(cfn) = SWSRC_SW1 + i;
+    CFN_FUNC(cfn) = FUNC_ADJUST_GVAR;
+    CFN_GVAR_INDEX(cfn) = i;
+    CFN_GVAR_MODE(cfn) = FUNC_ADJUST_GVAR_SOURCE;
+    CFN_PARAM(cfn) = MIXSRC_FIRST_STICK + i % NUM_STICKS;
+    CFN_ACTIVE(cfn) = 1;
+  }
+}
+
+static void runMixerBenchmark(const char * fixture, void (*setup)(), uint32_t iterations)
+{
+  if (!benchmarkSelected("mixer", fixture))
+    return;
+
+  mixerReset();
+  setup();
+  MIX_PLAN_INVALIDATE();
+  LS_PLAN_INVALIDATE();
+
+  // a first run to settle the mixer state (flight mode, delays, logical switches)
+  moveSticks(0);
+  evalMixes(1);
+
+  benchmarkPrintHeader("mixer", fixture, iterations);
+
+  // each stage is timed alone, what it depends on is evaluated untimed before it
+  benchmarkPrintResult("evalInputs", benchmarkMeasure(iterations, [](uint32_t i) {
+    moveSticks(i);
+  }, [](uint32_t) {
+    evalInputs(e_perout_mode_normal);
+  }));
+
+  benchmarkPrintResult("evalLogicalSwitches", benchmarkMeasure(iterations, [](uint32_t i) {
+    moveSticks(i);
+    evalInputs(e_perout_mode_normal);
+    LS_RECURSIVE_EVALUATION_RESET();
+  }, [](uint32_t) {
+    evalLogicalSwitches(true);
+  }));
+
+  // inputs, logical switches and mix loop of the current flight mode, with the 10ms paths (slow, delay)
+  benchmarkPrintResult("evalFlightModeMixes", benchmarkMeasure(iterations, [](uint32_t i) {
+    moveSticks(i);
+    LS_RECURSIVE_EVALUATION_RESET();
+  }, [](uint32_t) {
+    evalFlightModeMixes(e_perout_mode_normal, 1);
+  }));
+
+  benchmarkPrintResult("evalFunctions", benchmarkMeasure(iterations, [](uint32_t) {
+    evalFunctions(g_model.customFn, modelFunctionsContext);
+  }));
+
+  benchmarkPrintResult("applyLimits", benchmarkMeasure(iterations, [](uint32_t) {
+    for (uint8_t ch=0; ch<MAX_OUTPUT_CHANNELS; ch++) {
+      channelOutputs[ch] = applyLimits(ch, chans[ch]);
+    }
+  }));
+
+  benchmarkPrintResult("evalMixes", benchmarkMeasure(iterations, [](uint32_t i) {
+    moveSticks(i);
+  }, [](uint32_t) {
+    evalMixes(1);
+  }));
+
+  // g_tmr10ms moves each iteration, so that the fades and all the 10ms paths are run as on the radio
+  benchmarkPrintResult("doMixerCalculations", benchmarkMeasure(iterations, [](uint32_t i) {
+    moveSticks(i);
+    g_tmr10ms++;
+  }, [](uint32_t) {
+    doMixerCalculations();
+  }));
+}
+
+void runMixerBenchmarks(uint32_t iterations)
+{
+  for (int i=0; i<STICKS_SWEEP_LENGTH; i++) {
+    int v = (i < STICKS_SWEEP_LENGTH/2 ? i : STICKS_SWEEP_LENGTH - i);
+    sticksSweep[i] = -RESX + v * (4 * RESX / STICKS_SWEEP_LENGTH);
+  }
+
+  runMixerBenchmark("plain", setupPlainModel, iterations);
+#if defined(HELI)
+  runMixerBenchmark("heli", setupHeliModel, iterations);
+#endif
+  runMixerBenchmark("flightmodes-fade", setupFlightModesModel, iterations);
+  runMixerBenchmark("gvars", setupGVarsModel, iterations);
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(CPUARM)
+// byte per byte reference implementations
+static uint16_t referenceCrc16(const uint16_t * tab, const uint8_t * buf, uint32_t len, uint16_t crc)
+{
+  for (uint32_t i=0; i<len; i++) {
+    crc = (crc<<8) ^ tab[((crc>>8) ^ buf[i]) & 0xFF];
+  }
+  return crc;
+}
+
+static uint8_t referenceCrc8(const uint8_t * buf, uint32_t len)
+{
+  uint8_t crc = 0;
+  for (uint32_t i=0; i<len; i++) {
+    crc ^= buf[i];
+    for (uint8_t bit=0; bit<8; bit++) {
+      crc = (crc & 0x80) ? (crc << 1) ^ 0xD5 : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+TEST(Crc, slices)
+{
+  uint8_t buffer[67];
+  for (uint32_t i=0; i<sizeof(buffer); i++) {
+    buffer[i] = i * 37 + 11;
+  }
+
+  for (uint32_t len=0; len<=sizeof(buffer); len++) {
+    ASSERT_EQ(referenceCrc8(buffer, len), crc8(buffer, len));
+    ASSERT_EQ(referenceCrc16(crc16tab_1021, buffer, len, 0xFFFF), crc16(CRC_1021, buffer, len, 0xFFFF));
+    ASSERT_EQ(referenceCrc16(crc16tab_1189, buffer, len, 0), crc16(CRC_1189, buffer, len));
+  }
+}
+
+TEST(Crc, streaming)
+{
+  uint8_t buffer[50];
+  for (uint32_t i=0; i<sizeof(buffer); i++) {
+    buffer[i] = i * 73 + 5;
+  }
+
+  for (uint32_t split=0; split<=sizeof(buffer); split++) {
+    uint32_t remaining = sizeof(buffer) - split;
+    ASSERT_EQ(crc8(buffer, sizeof(buffer)), crc8(buffer + split, remaining, crc8(buffer, split)));
+    ASSERT_EQ(crc16(CRC_1021, buffer, sizeof(buffer)), crc16(CRC_1021, buffer + split, remaining, crc16(CRC_1021, buffer, split)));
+    ASSERT_EQ(checksum8(buffer, sizeof(buffer)), checksum8(buffer + split, remaining, checksum8(buffer, split)));
+  }
+}
+
+TEST(Crc, checksum8)
+{
+  uint8_t buffer[] = { 0x55, 0x0C, 0x14, 0xFF, 0x80, 0x81, 0x01, 0x03, 0xF4 };
+  uint8_t sum = 0;
+  for (uint32_t i=0; i<sizeof(buffer); i++) {
+    sum += buffer[i];
+  }
+  ASSERT_EQ(sum, checksum8(buffer, sizeof(buffer)));
+}
+#endif
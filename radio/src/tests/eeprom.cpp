@@ -43,6 +43,151 @@ TEST(Storage, BackupAndRestore)
   if (memcmp(&ramBackupUncompressed, &ramBackupRestored, sizeof(ramBackupUncompressed)) != 0)
     TRACE("ERROR restore");
 }
+
+const char * writeModel();
+const char * writeFile(const char * filename, const uint8_t * data, uint16_t size);
+
+#define JOURNAL_TEST_MODEL             "jtest.bin"
+#define JOURNAL_TEST_MODEL_PATH        MODELS_PATH "/jtest.bin"
+#define JOURNAL_TEST_JOURNAL_PATH      MODELS_PATH "/jtest.jnl"
+#define JOURNAL_TEST_REFERENCE_PATH    MODELS_PATH "/jref.bin"
+
+// the SD card is the current directory
+static void journalTestReset()
+{
+  simuFatfsSetPaths(NULL, NULL);
+  f_mkdir(MODELS_PATH);
+  f_unlink(JOURNAL_TEST_JOURNAL_PATH);
+  MODEL_RESET();
+  strcpy(g_eeGeneral.currModelFilename, JOURNAL_TEST_MODEL);
+  strcpy(g_model.header.name, "JOURNAL");
+  writeModel();
+}
+
+static uint32_t readRawFile(const char * path, uint8_t * buffer, uint32_t size)
+{
+  FIL file;
+  UINT read = 0;
+  if (f_open(&file, path, FA_OPEN_EXISTING | FA_READ) != FR_OK)
+    return 0;
+  f_read(&file, buffer, size, &read);
+  f_close(&file);
+  return read;
+}
+
+static bool journalExists()
+{
+  FILINFO fno;
+  return f_stat(JOURNAL_TEST_JOURNAL_PATH, &fno) == FR_OK;
+}
+
+static void journalModelChange()
+{
+  storageDirty(EE_MODEL);
+  storageCheck(false);
+}
+
+TEST(Storage, ModelJournalReplay)
+{
+  journalTestReset();
+
+  g_model.mixData[0].weight = 42;
+  journalModelChange();
+  g_model.flightModeData[0].trim[1].value = -10;
+  g_model.logicalSw[3].v2 = 500;
+  journalModelChange();
+  EXPECT_TRUE(journalExists());
+
+  // the model file is unchanged until the journal is compacted
+  ModelData model;
+  EXPECT_EQ(readModel(JOURNAL_TEST_MODEL, (uint8_t *)&model, sizeof(model)), (const char *)NULL);
+  EXPECT_EQ(model.mixData[0].weight, 0);
+
+  ModelData expected;
+  memcpy(&expected, &g_model, sizeof(expected));
+  MODEL_RESET();
+  EXPECT_EQ(loadModelFile(JOURNAL_TEST_MODEL), (const char *)NULL);
+
+  EXPECT_FALSE(journalExists());
+  EXPECT_EQ(readModel(JOURNAL_TEST_MODEL, (uint8_t *)&model, sizeof(model)), (const char *)NULL);
+  EXPECT_EQ(memcmp(&model, &expected, sizeof(model)), 0);
+}
+
+TEST(Storage, ModelJournalTornRecord)
+{
+  journalTestReset();
+
+  g_model.mixData[0].weight = 42;
+  journalModelChange();
+  ModelData expected;
+  memcpy(&expected, &g_model, sizeof(expected));
+  g_model.mixData[1].weight = 43;
+  journalModelChange();
+
+  // the radio was switched off while writing the last record
+  FILINFO fno;
+  ASSERT_EQ(f_stat(JOURNAL_TEST_JOURNAL_PATH, &fno), FR_OK);
+  FIL file;
+  ASSERT_EQ(f_open(&file, JOURNAL_TEST_JOURNAL_PATH, FA_OPEN_EXISTING | FA_WRITE), FR_OK);
+  f_lseek(&file, fno.fsize - 3);
+  f_truncate(&file);
+  f_close(&file);
+
+  MODEL_RESET();
+  EXPECT_EQ(loadModelFile(JOURNAL_TEST_MODEL), (const char *)NULL);
+
+  ModelData model;
+  EXPECT_FALSE(journalExists());
+  EXPECT_EQ(readModel(JOURNAL_TEST_MODEL, (uint8_t *)&model, sizeof(model)), (const char *)NULL);
+  EXPECT_EQ(memcmp(&model, &expected, sizeof(model)), 0);
+}
+
+TEST(Storage, ModelJournalStale)
+{
+  journalTestReset();
+
+  g_model.mixData[0].weight = 42;
+  journalModelChange();
+  EXPECT_TRUE(journalExists());
+
+  // the model file has been replaced, the journal does not apply to it any more
+  ModelData expected;
+  memclear(&expected, sizeof(expected));
+  strcpy(expected.header.name, "REPLACED");
+  writeFile(JOURNAL_TEST_MODEL_PATH, (uint8_t *)&expected, sizeof(expected));
+
+  MODEL_RESET();
+  EXPECT_EQ(loadModelFile(JOURNAL_TEST_MODEL), (const char *)NULL);
+
+  ModelData model;
+  EXPECT_FALSE(journalExists());
+  EXPECT_EQ(readModel(JOURNAL_TEST_MODEL, (uint8_t *)&model, sizeof(model)), (const char *)NULL);
+  EXPECT_EQ(memcmp(&model, &expected, sizeof(model)), 0);
+}
+
+TEST(Storage, ModelJournalCompaction)
+{
+  journalTestReset();
+
+  for (uint8_t i=0; i<10; i++) {
+    g_model.mixData[i].weight = 10 + i;
+    g_model.flightModeData[0].trim[i % NUM_STICKS].value = i;
+    journalModelChange();
+  }
+  EXPECT_TRUE(journalExists());
+
+  storageCheck(true);
+  EXPECT_FALSE(journalExists());
+
+  // the same bytes as a full write of the model
+  static uint8_t compacted[sizeof(ModelData) + 8];
+  static uint8_t reference[sizeof(ModelData) + 8];
+  writeFile(JOURNAL_TEST_REFERENCE_PATH, (uint8_t *)&g_model, sizeof(g_model));
+  EXPECT_EQ(readRawFile(JOURNAL_TEST_MODEL_PATH, compacted, sizeof(compacted)), sizeof(compacted));
+  EXPECT_EQ(readRawFile(JOURNAL_TEST_REFERENCE_PATH, reference, sizeof(reference)), sizeof(reference));
+  EXPECT_EQ(memcmp(compacted, reference, sizeof(compacted)), 0);
+  f_unlink(JOURNAL_TEST_REFERENCE_PATH);
+}
 #endif
 
 #if defined(EEPROM_RLC)
@@ -421,6 +421,7 @@ TEST(FrSkySPORT, frskySetCellVoltageTwoSensors)
   g_model.telemetrySensors[2].prec = 1;
   g_model.telemetrySensors[2].calc.sources[0] = 1;
   g_model.telemetrySensors[2].calc.sources[1] = 2;
+  invalidateTelemetrySensorsIndex();
 
   telemetryWakeup();
 
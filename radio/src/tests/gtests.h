@@ -61,6 +61,14 @@ inline void MODEL_RESET()
   extern uint8_t s_mixer_first_run_done;
   s_mixer_first_run_done = false;
   lastFlightMode = 255;
+  MIX_PLAN_INVALIDATE();
+  LS_PLAN_INVALIDATE();
+#if defined(CPUARM)
+  invalidateTelemetrySensorsIndex();
+#endif
+#if defined(CPUARM) && defined(CURVES)
+  invalidateCurveTangents();
+#endif
 }
 
 inline void MIXER_RESET()
@@ -92,6 +100,7 @@ inline void TELEMETRY_RESET()
   }
 #endif
   memclear(g_model.telemetrySensors, sizeof(g_model.telemetrySensors));
+  invalidateTelemetrySensorsIndex();
 #endif
 }
 
@@ -55,6 +55,7 @@ void setLogicalSwitch(int index, uint16_t _func, int16_t _v1, int16_t _v2, int16
   g_model.logicalSw[index].delay = _delay;
   g_model.logicalSw[index].duration = _duration;
   g_model.logicalSw[index].andsw = _andsw;
+  LS_PLAN_INVALIDATE();
 }
 #endif
 
@@ -93,6 +94,39 @@ TEST(getSwitch, OldTypeStickyCSW)
 }
 #endif
 
+#if defined(PCBTARANIS)
+TEST(evalLogicalSwitches, dependenciesOrder)
+{
+  RADIO_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+
+  // L1 reads L3 which reads L2, they are evaluated in dependencies order
+  setLogicalSwitch(0, LS_FUNC_AND, SWSRC_SW3, SWSRC_NONE);
+  setLogicalSwitch(1, LS_FUNC_AND, SWSRC_SA0, SWSRC_NONE);
+  setLogicalSwitch(2, LS_FUNC_AND, SWSRC_SW2, SWSRC_NONE);
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW3), false);
+
+  // all switches follow SA0 in the same evaluation
+  simuSetSwitch(0, -1);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), true);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), true);
+  EXPECT_EQ(getSwitch(SWSRC_SW3), true);
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW3), false);
+}
+#endif
+
 TEST(getSwitch, nullSW)
 {
   MODEL_RESET();